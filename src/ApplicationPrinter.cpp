@@ -1,3 +1,6 @@
 #include "ApplicationPrinter.hpp"
 
 YamlPrinter ApplicationPrinter::m_printer;
+#if defined __link
+thread_local YamlPrinter * ApplicationPrinter::m_thread_printer = 0;
+#endif
@@ -5,10 +5,35 @@
 
 class ApplicationPrinter {
 public:
-	static YamlPrinter & printer(){ return m_printer; }
+	static YamlPrinter & printer(){
+#if defined __link
+		if( m_thread_printer ){ return *m_thread_printer; }
+#endif
+		return m_printer;
+	}
+
+	/*! \details Returns true if debug output is printed.
+	 *
+	 * Use this to skip building data that is only printed for
+	 * debugging.
+	 *
+	 */
+	static bool is_debug(){
+		return printer().verbose_level() >= Printer::DEBUG;
+	}
+
+	/*! \details Redirects printer() for the calling thread (0 to restore). */
+	static void set_thread_printer(YamlPrinter * printer){
+#if defined __link
+		m_thread_printer = printer;
+#endif
+	}
 
 private:
 	static YamlPrinter m_printer;
+#if defined __link
+	static thread_local YamlPrinter * m_thread_printer;
+#endif
 };
 
 typedef ApplicationPrinter Ap;
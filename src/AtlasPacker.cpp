@@ -0,0 +1,147 @@
+/*! \file */ //Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+#include "AtlasPacker.hpp"
+
+AtlasPacker::AtlasPacker(const Area & bin_area){
+	m_bin_area = bin_area;
+}
+
+int AtlasPacker::insert(const Area & area, Point & point){
+	if( (area.width() > m_bin_area.width()) ||
+		 (area.height() > m_bin_area.height()) ){
+		return -1;
+	}
+
+	u32 x;
+	u32 y;
+	for(u32 i=0; i < m_bins.count(); i++){
+		if( find_position(m_bins.at(i), area, x, y) ){
+			add_level(m_bins.at(i), x, y, area);
+			point = Point(x, y);
+			return i;
+		}
+	}
+
+	//an empty bin is a single segment at the top
+	skyline_t skyline;
+	skyline_segment_t segment;
+	segment.x = 0;
+	segment.y = 0;
+	segment.width = m_bin_area.width();
+	skyline.push_back(segment);
+
+	add_level(skyline, 0, 0, area);
+	m_bins.push_back(skyline);
+	point = Point(0, 0);
+	return m_bins.count() - 1;
+}
+
+bool AtlasPacker::fit_segment(
+		const skyline_t & skyline,
+		u32 index,
+		const Area & area,
+		u32 & y
+		) const {
+	u32 x = skyline.at(index).x;
+	if( x + area.width() > m_bin_area.width() ){
+		return false;
+	}
+
+	//the rectangle rests on the highest segment it spans
+	u32 remaining = area.width();
+	y = 0;
+	for(u32 i = index; remaining > 0; i++){
+		const skyline_segment_t & segment = skyline.at(i);
+		if( segment.y > y ){
+			y = segment.y;
+		}
+
+		if( y + area.height() > m_bin_area.height() ){
+			return false;
+		}
+
+		remaining = segment.width >= remaining ? 0 : remaining - segment.width;
+	}
+
+	return true;
+}
+
+bool AtlasPacker::find_position(
+		const skyline_t & skyline,
+		const Area & area,
+		u32 & x,
+		u32 & y
+		) const {
+	bool is_found = false;
+	for(u32 i=0; i < skyline.count(); i++){
+		u32 fit_y;
+		if( fit_segment(skyline, i, area, fit_y) ){
+			if( !is_found || (fit_y < y) ){
+				is_found = true;
+				x = skyline.at(i).x;
+				y = fit_y;
+			}
+		}
+	}
+	return is_found;
+}
+
+void AtlasPacker::add_level(
+		skyline_t & skyline,
+		u32 x,
+		u32 y,
+		const Area & area
+		){
+	skyline_segment_t level;
+	level.x = x;
+	level.y = y + area.height();
+	level.width = area.width();
+
+	//rebuild the skyline with the new level replacing what it covers
+	skyline_t result;
+	u32 level_end = x + area.width();
+	bool is_inserted = false;
+	for(const auto & segment: skyline){
+		u32 segment_end = segment.x + segment.width;
+		if( (segment_end <= x) || (segment.x >= level_end) ){
+			if( !is_inserted && (segment.x >= level_end) ){
+				result.push_back(level);
+				is_inserted = true;
+			}
+			result.push_back(segment);
+			continue;
+		}
+
+		if( segment.x < x ){
+			skyline_segment_t left = segment;
+			left.width = x - segment.x;
+			result.push_back(left);
+		}
+
+		if( !is_inserted ){
+			result.push_back(level);
+			is_inserted = true;
+		}
+
+		if( segment_end > level_end ){
+			skyline_segment_t right = segment;
+			right.x = level_end;
+			right.width = segment_end - level_end;
+			result.push_back(right);
+		}
+	}
+
+	if( !is_inserted ){
+		result.push_back(level);
+	}
+
+	//merge neighbors at the same height
+	skyline = skyline_t();
+	for(const auto & segment: result){
+		if( skyline.count() && (skyline.at(skyline.count()-1).y == segment.y) ){
+			skyline.at(skyline.count()-1).width += segment.width;
+		} else {
+			skyline.push_back(segment);
+		}
+	}
+}
@@ -0,0 +1,52 @@
+/*! \file */ //Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+
+#ifndef ATLASPACKER_HPP_
+#define ATLASPACKER_HPP_
+
+#include <sapi/var.hpp>
+#include <sapi/sgfx.hpp>
+
+/*! \details Packs rectangles into fixed size bins (master canvases).
+ *
+ * Each bin keeps a skyline: the top edge of the packed rectangles
+ * as a list of horizontal segments. A rectangle is placed at the
+ * lowest position where it fits (then the leftmost) so no pixels
+ * are probed. Inserting rectangles in order of decreasing height
+ * gives the tightest packing.
+ *
+ */
+class AtlasPacker {
+public:
+	AtlasPacker(const Area & bin_area);
+
+	/*! \details Finds space for a rectangle of \a area.
+	 *
+	 * Bins are tried in order and a new bin is opened if the
+	 * rectangle does not fit in any of them. Returns the bin index
+	 * and sets \a point to the top left corner, or returns -1 if the
+	 * rectangle is larger than a bin.
+	 *
+	 */
+	int insert(const Area & area, Point & point);
+
+	u32 bin_count() const { return m_bins.count(); }
+
+private:
+	typedef struct {
+		u32 x;
+		u32 y;
+		u32 width;
+	} skyline_segment_t;
+
+	typedef var::Vector<skyline_segment_t> skyline_t;
+
+	Area m_bin_area;
+	var::Vector<skyline_t> m_bins;
+
+	bool find_position(const skyline_t & skyline, const Area & area, u32 & x, u32 & y) const;
+	bool fit_segment(const skyline_t & skyline, u32 index, const Area & area, u32 & y) const;
+	void add_level(skyline_t & skyline, u32 x, u32 y, const Area & area);
+};
+
+#endif /* ATLASPACKER_HPP_ */
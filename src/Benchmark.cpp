@@ -0,0 +1,1970 @@
+/*! \file */ //Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+#include <cctype>
+#include <cstring>
+#include <sapi/chrono.hpp>
+#include <sapi/fmt.hpp>
+#include "Benchmark.hpp"
+#include "SvgFontManager.hpp"
+#include "InputFile.hpp"
+#include "WorkerPool.hpp"
+#include "CodePointSet.hpp"
+#include "RegionMap.hpp"
+#include "RowScanner.hpp"
+#include "RunTable.hpp"
+#include "DistanceMap.hpp"
+#include "ScratchPool.hpp"
+#include "WindingIndex.hpp"
+#include "ScanlineRasterizer.hpp"
+
+int Benchmark::run(
+		const var::String & name,
+		fs::File::SourcePath input,
+		Iterations iterations
+		){
+
+	if( name == "path" ){
+		return run_path_parser(input, iterations);
+	}
+
+	if( name == "icons" ){
+		return run_icon_conversion(input);
+	}
+
+	if( name == "codepoints" ){
+		return run_code_point_index(iterations);
+	}
+
+	if( name == "fill" ){
+		return run_fill_comparison(input, iterations);
+	}
+
+	if( name == "regions" ){
+		return run_region_grouping(input, iterations);
+	}
+
+	if( name == "rows" ){
+		return run_row_scan(input, iterations);
+	}
+
+	if( name == "multires" ){
+		return run_multires_search(input, iterations);
+	}
+
+	if( name == "winding" ){
+		return run_winding_test(input, iterations);
+	}
+
+	if( name == "grid" ){
+		return run_pour_grid(input, iterations);
+	}
+
+	if( name == "flatness" ){
+		return run_flattening(input, iterations);
+	}
+
+	if( name == "fit" ){
+		return run_icon_fit(input);
+	}
+
+	printer().error(
+				"unknown benchmark '%s' use --benchmark=path|icons|codepoints|regions|rows|fill|multires|winding|grid|flatness|fit",
+				name.cstring()
+				);
+	return -1;
+}
+
+var::Vector<var::String> Benchmark::get_svg_file_list(const var::String & path){
+	var::Vector<var::String> result;
+	if( File::get_info(path).is_directory() ){
+		result = Dir::read_list(
+					path,
+					[](const String & entry)
+					-> const String {
+			return (FileInfo::suffix(entry) == "svg") ?
+						entry :
+						String();
+		});
+
+		for(auto & entry: result){
+			entry = path + "/" + entry;
+		}
+	} else {
+		result.push_back(path);
+	}
+	return result;
+}
+
+int Benchmark::run_path_parser(
+		fs::File::SourcePath input,
+		Iterations iterations
+		){
+
+	var::Vector<var::String> font_list = get_svg_file_list(input.argument());
+
+	printer().open_object("benchmark.path");
+	printer().key("iterations", "%ld", iterations.argument());
+
+	for(const auto & font_path: font_list){
+		JsonObject font =
+				JsonDocument().load(
+					JsonDocument::XmlFilePath(font_path)
+					).to_object()
+				.at("svg").to_object()
+				.at("defs").to_object()
+				.at("font").to_object();
+
+		JsonArray glyphs = font.at("glyph").to_array();
+		u16 units_per_em =
+				font.at("font-face").to_object()
+				.at("@units-per-em").to_string().to_integer();
+
+		if( (glyphs.count() == 0) || (units_per_em == 0) ){
+			printer().warning("no glyphs found in %s", font_path.cstring());
+			continue;
+		}
+
+		var::Vector<var::String> path_list;
+		for(u32 i=0; i < glyphs.count(); i++){
+			String d = glyphs.at(i).to_object().at("@d").to_string();
+			if( d.is_empty() == false ){
+				path_list.push_back(d);
+			}
+		}
+
+		SvgFontManager svg_font;
+		svg_font.set_flip_y(true);
+		svg_font.m_scale = (SG_MAP_MAX*1.0f) / (units_per_em);
+
+		u32 lexer_element_count = 0;
+		u32 tokenizer_element_count = 0;
+		u32 mismatch_count = 0;
+		ClockTimer timer;
+
+		timer.start();
+		for(u32 i=0; i < iterations.argument(); i++){
+			for(const auto & d: path_list){
+				lexer_element_count += svg_font.process_svg_path(d).count();
+			}
+		}
+		timer.stop();
+		u32 lexer_microseconds = timer.microseconds();
+
+		timer.restart();
+		for(u32 i=0; i < iterations.argument(); i++){
+			for(const auto & d: path_list){
+				tokenizer_element_count += svg_font.process_svg_path_tokenized(d).count();
+			}
+		}
+		timer.stop();
+		u32 tokenizer_microseconds = timer.microseconds();
+
+		//both parsers should produce the same elements per glyph -- the
+		//tokenizer reads the pairs after M as more moves (rather than lines)
+		//so those paths are left out
+		u32 excluded_count = 0;
+		for(const auto & d: path_list){
+			if( is_implicit_line(d) ){
+				excluded_count++;
+				continue;
+			}
+
+			var::Vector<sg_vector_path_description_t> lexer_elements =
+					svg_font.process_svg_path(d);
+			var::Vector<sg_vector_path_description_t> tokenizer_elements =
+					svg_font.process_svg_path_tokenized(d);
+
+			bool is_equal = lexer_elements.count() == tokenizer_elements.count();
+			for(u32 i=0; is_equal && (i < lexer_elements.count()); i++){
+				is_equal = is_element_equal(lexer_elements.at(i), tokenizer_elements.at(i));
+			}
+
+			if( is_equal == false ){
+				printer().debug("elements differ for %s", d.cstring());
+				mismatch_count++;
+			}
+		}
+
+		printer().open_object(FileInfo::name(font_path));
+		{
+			printer().key("glyphs", "%ld", path_list.count());
+			printer().key("elements", "%ld", lexer_element_count / iterations.argument());
+			printer().key("lexer", "%ldus", lexer_microseconds);
+			printer().key("tokenizer", "%ldus", tokenizer_microseconds);
+			printer().key(
+						"speedup",
+						"%0.2fx",
+						lexer_microseconds ?
+							tokenizer_microseconds * 1.0f / lexer_microseconds :
+							0.0f
+							);
+			printer().key("compared", "%ld", path_list.count() - excluded_count);
+			printer().key("mismatches", "%ld", mismatch_count);
+			printer().close_object();
+		}
+
+		if( tokenizer_element_count != lexer_element_count ){
+			printer().warning(
+						"element count differs (%ld != %ld)",
+						lexer_element_count,
+						tokenizer_element_count
+						);
+		}
+	}
+
+	printer().close_object();
+	return 0;
+}
+
+bool Benchmark::is_element_equal(
+		const sg_vector_path_description_t & a,
+		const sg_vector_path_description_t & b
+		){
+	if( a.type != b.type ){
+		return false;
+	}
+
+	sg_point_t a_points[3];
+	sg_point_t b_points[3];
+	u32 count = 1;
+	switch(a.type){
+		case SG_VECTOR_PATH_MOVE:
+			a_points[0] = a.move.point;
+			b_points[0] = b.move.point;
+			break;
+		case SG_VECTOR_PATH_LINE:
+			a_points[0] = a.line.point;
+			b_points[0] = b.line.point;
+			break;
+		case SG_VECTOR_PATH_POUR:
+			a_points[0] = a.pour.point;
+			b_points[0] = b.pour.point;
+			break;
+		case SG_VECTOR_PATH_QUADRATIC_BEZIER:
+			a_points[0] = a.quadratic_bezier.control;
+			b_points[0] = b.quadratic_bezier.control;
+			a_points[1] = a.quadratic_bezier.point;
+			b_points[1] = b.quadratic_bezier.point;
+			count = 2;
+			break;
+		case SG_VECTOR_PATH_CUBIC_BEZIER:
+			a_points[0] = a.cubic_bezier.control[0];
+			b_points[0] = b.cubic_bezier.control[0];
+			a_points[1] = a.cubic_bezier.control[1];
+			b_points[1] = b.cubic_bezier.control[1];
+			a_points[2] = a.cubic_bezier.point;
+			b_points[2] = b.cubic_bezier.point;
+			count = 3;
+			break;
+		default:
+			//close has no points
+			return true;
+	}
+
+	for(u32 i=0; i < count; i++){
+		if( (a_points[i].x != b_points[i].x) || (a_points[i].y != b_points[i].y) ){
+			return false;
+		}
+	}
+	return true;
+}
+
+bool Benchmark::is_implicit_line(const var::String & d){
+	const char * c = d.cstring();
+	bool is_move = false;
+	u32 number_count = 0;
+
+	//counts the numbers after each M or m -- more than one pair continues as lines
+	while( *c ){
+		if( isalpha(*c) && (*c != 'e') && (*c != 'E') ){
+			is_move = (*c == 'M') || (*c == 'm');
+			number_count = 0;
+			c++;
+		} else if( isdigit(*c) || (*c == '.') || (*c == '-') || (*c == '+') ){
+			bool has_dot = false;
+			if( (*c == '-') || (*c == '+') ){
+				c++;
+			}
+			while( isdigit(*c) || ((*c == '.') && (has_dot == false)) ){
+				if( *c == '.' ){ has_dot = true; }
+				c++;
+			}
+			if( (*c == 'e') || (*c == 'E') ){
+				c++;
+				if( (*c == '-') || (*c == '+') ){
+					c++;
+				}
+				while( isdigit(*c) ){
+					c++;
+				}
+			}
+			number_count++;
+			if( is_move && (number_count > 2) ){
+				return true;
+			}
+		} else {
+			c++;
+		}
+	}
+	return false;
+}
+
+bool Benchmark::is_file_equal(const var::String & a, const var::String & b){
+	InputFile first;
+	InputFile second;
+	if( (first.open(a) < 0) || (second.open(b) < 0) ){
+		return false;
+	}
+
+	return (first.size() == second.size()) &&
+			(memcmp(first.data(), second.data(), first.size()) == 0);
+}
+
+int Benchmark::run_icon_conversion(
+		fs::File::SourcePath input
+		){
+	const u32 job_list[] = { 1, 2, 4, 8, 16 };
+	u32 serial_milliseconds = 0;
+	var::String serial_output;
+
+	printer().open_object("benchmark.icons");
+	printer().key("hardwareConcurrency", "%ld", WorkerPool::get_hardware_concurrency());
+
+	for(u32 jobs: job_list){
+		var::String output = var::String().format("benchmark-icons-%ld.svic", jobs);
+
+		SvgFontManager svg_font;
+		svg_font.set_bits_per_pixel(1);
+		svg_font.set_output_json(false);
+		svg_font.set_pour_grid_size(3);
+		svg_font.set_canvas_size(128);
+		svg_font.set_downsample_factor(Area(4,4));
+		svg_font.set_flip_y(false);
+		svg_font.set_jobs(jobs);
+
+		ClockTimer timer;
+		timer.start();
+		int result = svg_font.process_icons(
+					input,
+					File::DestinationPath(output)
+					);
+		timer.stop();
+
+		if( result < 0 ){
+			printer().error("failed to convert icons with %ld jobs", jobs);
+			printer().close_object();
+			return -1;
+		}
+
+		if( jobs == 1 ){
+			serial_milliseconds = timer.milliseconds();
+			serial_output = output;
+		}
+
+		printer().open_object(var::String().format("jobs-%ld", jobs));
+		{
+			printer().key("time", "%ldms", timer.milliseconds());
+			printer().key(
+						"speedup",
+						"%0.2fx",
+						timer.milliseconds() ?
+							serial_milliseconds * 1.0f / timer.milliseconds() :
+							0.0f
+							);
+			if( jobs != 1 ){
+				printer().key(
+							"identical",
+							is_file_equal(serial_output, output) ? "true" : "false"
+							);
+				File::remove(output);
+			}
+			printer().close_object();
+		}
+	}
+
+	File::remove(serial_output);
+	printer().close_object();
+	return 0;
+}
+
+int Benchmark::run_code_point_index(Iterations iterations){
+	const u32 glyph_count_list[] = { 100, 1000, 10000 };
+
+	printer().open_object("benchmark.codepoints");
+	printer().key("iterations", "%ld", iterations.argument());
+
+	for(u32 glyph_count: glyph_count_list){
+		//every requested character is offered twice and produced once
+		u32 linear_found = 0;
+		u32 index_found = 0;
+		ClockTimer timer;
+
+		timer.start();
+		for(u32 i=0; i < iterations.argument(); i++){
+			var::Vector<u16> character_list;
+			for(u32 pass=0; pass < 2; pass++){
+				for(u32 code_point=0; code_point < glyph_count; code_point++){
+					bool is_found = false;
+					for(const auto id: character_list){
+						if( id == code_point ){
+							is_found = true;
+							break;
+						}
+					}
+					if( is_found == false ){
+						character_list.push_back(code_point);
+					}
+				}
+			}
+
+			//missing character check
+			for(u32 code_point=0; code_point < glyph_count; code_point++){
+				for(const auto id: character_list){
+					if( id == code_point ){
+						linear_found++;
+						break;
+					}
+				}
+			}
+		}
+		timer.stop();
+		u32 linear_microseconds = timer.microseconds();
+
+		timer.restart();
+		for(u32 i=0; i < iterations.argument(); i++){
+			CodePointSet loaded;
+			var::Vector<u16> character_list;
+			for(u32 pass=0; pass < 2; pass++){
+				for(u32 code_point=0; code_point < glyph_count; code_point++){
+					if( loaded.insert(code_point) ){
+						character_list.push_back(code_point);
+					}
+				}
+			}
+
+			for(u32 code_point=0; code_point < glyph_count; code_point++){
+				if( loaded.contains(code_point) ){
+					index_found++;
+				}
+			}
+		}
+		timer.stop();
+		u32 index_microseconds = timer.microseconds();
+
+		printer().open_object(var::String().format("glyphs-%ld", glyph_count));
+		{
+			printer().key("linear", "%ldus", linear_microseconds / iterations.argument());
+			printer().key("index", "%ldus", index_microseconds / iterations.argument());
+			printer().key(
+						"indexPerGlyph",
+						"%0.1fns",
+						index_microseconds * 1000.0f / iterations.argument() / glyph_count
+						);
+			if( linear_found != index_found ){
+				printer().key("mismatch", "%ld != %ld", linear_found, index_found);
+			}
+			printer().close_object();
+		}
+	}
+
+	printer().close_object();
+	return 0;
+}
+
+var::Vector<int> Benchmark::group_by_pour(
+		const sgfx::Bitmap & bitmap,
+		const var::Vector<FillPoint> & fill_points
+		){
+	//one canvas copy and flood fill per group (the grouping RegionMap replaced)
+	var::Vector<int> result;
+	result.resize(fill_points.count());
+	for(auto & group: result){
+		group = -1;
+	}
+
+	int group_count = 0;
+	for(u32 i=0; i < fill_points.count(); i++){
+		if( result.at(i) < 0 ){
+			Bitmap fill_bitmap(
+						bitmap.area(),
+						Bitmap::BitsPerPixel(1)
+						);
+			fill_bitmap.clear();
+			fill_bitmap.set_pen( Pen().set_color(1) );
+			fill_bitmap.draw_bitmap(Point(0,0), bitmap);
+			fill_bitmap.draw_pour(fill_points.at(i).point(), fill_bitmap.region());
+
+			result.at(i) = group_count;
+			for(u32 j = i+1; j < fill_points.count(); j++){
+				if( fill_bitmap.get_pixel(fill_points.at(j).point()) != 0 ){
+					result.at(j) = group_count;
+				}
+			}
+			group_count++;
+		}
+	}
+	return result;
+}
+
+sg_size_t Benchmark::get_y_fill_spacing_by_scan(
+		const sgfx::Bitmap & bitmap,
+		Point point
+		){
+	//walks the column from the point (the scan RegionMap::y_spacing() replaced)
+	sg_size_t top_spacing = 0;
+	sg_size_t bottom_spacing = 0;
+	sg_color_t pixel;
+	Point start_point = point;
+	do {
+		pixel = bitmap.get_pixel(point);
+		bottom_spacing++;
+		point += Point::Y(1);
+	} while( (pixel == 0) && (point.y() < bitmap.height()) );
+
+	if( (point.y() == bitmap.height()) && (pixel == 0) ){
+		return 0;
+	}
+
+	point = start_point;
+	do {
+		pixel = bitmap.get_pixel(point);
+		top_spacing++;
+		point -= Point::Y(1);
+	} while( (pixel == 0) && (point.y() > 0) );
+
+	if( (point.y() == 0) && (pixel == 0) ){
+		return 0;
+	}
+
+	return top_spacing < bottom_spacing ? top_spacing : bottom_spacing;
+}
+
+var::Vector<Point> Benchmark::find_fill_points_by_pour(
+		SvgFontManager & svg_font,
+		const sgfx::Bitmap & bitmap
+		){
+	var::Vector<Point> result;
+	var::Vector<FillPoint> candidate_list[2];
+	var::Vector<int> group_list[2];
+	int group_count[2] = {0, 0};
+
+	RunTable run_table(bitmap);
+	for(u32 pass = 0; pass < 2; pass++){
+		candidate_list[pass] = svg_font.find_fill_point_candidates(
+					run_table,
+					bitmap.get_viewable_region(),
+					svg_font.m_pour_grid_size,
+					pass == 1
+					);
+		group_list[pass] = group_by_pour(bitmap, candidate_list[pass]);
+		for(const auto group: group_list[pass]){
+			if( group >= group_count[pass] ){
+				group_count[pass] = group + 1;
+			}
+		}
+	}
+
+	var::Vector<FillPoint> & candidates = candidate_list[0];
+	var::Vector<FillPoint> & negative_candidates = candidate_list[1];
+
+	//one flood fill per pair of positive and negative groups
+	for(int group = 0; group < group_count[0]; group++){
+		u32 group_size = 0;
+		for(const auto value: group_list[0]){
+			if( value == group ){ group_size++; }
+		}
+
+		for(int negative_group = 0; negative_group < group_count[1]; negative_group++){
+			u32 negative_size = 0;
+			u32 first = negative_candidates.count();
+			for(u32 i=0; i < negative_candidates.count(); i++){
+				if( group_list[1].at(i) == negative_group ){
+					if( first == negative_candidates.count() ){ first = i; }
+					negative_size++;
+				}
+			}
+
+			Bitmap fill_bitmap(bitmap.area(), Bitmap::BitsPerPixel(1));
+			fill_bitmap.clear();
+			fill_bitmap.draw_bitmap(Point(0,0), bitmap);
+			fill_bitmap.draw_pour(negative_candidates.at(first).point(), fill_bitmap.region());
+
+			for(u32 i=0; i < candidates.count(); i++){
+				if( (candidates.at(i).group() != -2) &&
+					 (group_list[0].at(i) == group) &&
+					 (fill_bitmap.get_pixel(candidates.at(i).point()) != 0) &&
+					 (group_size < negative_size) ){
+					candidates.at(i).set_group(-2);
+				}
+			}
+		}
+
+		sg_size_t spacing = 0;
+		u32 best_point = 0;
+		for(u32 i=0; i < candidates.count(); i++){
+			if( (group_list[0].at(i) == group) && (candidates.at(i).group() != -2) ){
+				sg_size_t x_spacing = candidates.at(i).spacing();
+				if( x_spacing > spacing ){
+					sg_size_t y_spacing = get_y_fill_spacing_by_scan(bitmap, candidates.at(i).point());
+					if( y_spacing > spacing ){
+						spacing = x_spacing > y_spacing ? y_spacing : x_spacing;
+						best_point = i;
+					}
+				}
+			}
+		}
+
+		if( (spacing > 0) && (group_size > 2) ){
+			result.push_back(candidates.at(best_point).point());
+		}
+	}
+
+	return result;
+}
+
+void Benchmark::load_shape_list(
+		fs::File::SourcePath input,
+		SvgFontManager & svg_font,
+		var::Vector<var::String> & path_list,
+		var::Vector<var::String> & view_box_list,
+		var::Vector<u32> & units_per_em_list
+		){
+	var::Vector<var::String> file_list = get_svg_file_list(input.argument());
+	bool is_icons = File::get_info(input.argument()).is_directory();
+
+	//fonts hold many glyphs, a directory holds one icon per file
+	for(const auto & file_path: file_list){
+		if( is_icons ){
+			String name;
+			String view_box;
+			var::Vector<String> drawing_paths;
+			if( (svg_font.read_svg_icon(file_path, name, view_box, drawing_paths) == 1) &&
+				 view_box.is_empty() == false ){
+				path_list.push_back(drawing_paths.at(0));
+				view_box_list.push_back(view_box);
+				units_per_em_list.push_back(0);
+			}
+			continue;
+		}
+
+		JsonObject font =
+				JsonDocument().load(
+					JsonDocument::XmlFilePath(file_path)
+					).to_object()
+				.at("svg").to_object()
+				.at("defs").to_object()
+				.at("font").to_object();
+
+		JsonObject font_face = font.at("font-face").to_object();
+		JsonArray glyphs = font.at("glyph").to_array();
+		String bbox = font_face.at("@bbox").to_string();
+		u32 units_per_em = font_face.at("@units-per-em").to_string().to_integer();
+		if( bbox.is_empty() || (units_per_em == 0) ){
+			printer().warning("no font face found in %s", file_path.cstring());
+			continue;
+		}
+
+		for(u32 i=0; i < glyphs.count(); i++){
+			String d = glyphs.at(i).to_object().at("@d").to_string();
+			if( d.is_empty() == false ){
+				path_list.push_back(d);
+				view_box_list.push_back(bbox);
+				units_per_em_list.push_back(units_per_em);
+			}
+		}
+	}
+}
+
+int Benchmark::run_region_grouping(
+		fs::File::SourcePath input,
+		Iterations iterations
+		){
+
+	printer().open_object("benchmark.regions");
+	printer().key("iterations", "%ld", iterations.argument());
+
+	SvgFontManager svg_font;
+	svg_font.set_bits_per_pixel(1);
+	svg_font.set_canvas_size(128);
+	svg_font.set_pour_grid_size(3);
+
+	var::Vector<var::String> path_list;
+	var::Vector<var::String> view_box_list;
+	var::Vector<u32> units_per_em_list; //zero for icons
+	load_shape_list(input, svg_font, path_list, view_box_list, units_per_em_list);
+
+	u32 shape_count = 0;
+	u32 point_count = 0;
+	u32 pour_microseconds = 0;
+	u32 label_microseconds = 0;
+	u32 mismatch_count = 0;
+	u32 moved_count = 0;
+	float spacing_clearance = 0.0f;
+	float distance_clearance = 0.0f;
+	ClockTimer timer;
+
+	for(u32 i=0; i < path_list.count(); i++){
+		Bitmap canvas;
+		canvas.set_bits_per_pixel(1);
+		if( draw_outline(
+				 svg_font,
+				 path_list.at(i),
+				 view_box_list.at(i),
+				 units_per_em_list.at(i),
+				 canvas) < 0 ){
+			continue;
+		}
+
+		var::Vector<Point> pour_points;
+		timer.restart();
+		for(u32 j=0; j < iterations.argument(); j++){
+			pour_points = find_fill_points_by_pour(svg_font, canvas);
+		}
+		timer.stop();
+		pour_microseconds += timer.microseconds();
+
+		//the pour reference picks points by spacing
+		var::Vector<Point> label_points;
+		svg_font.set_pour_select(SvgFontManager::POUR_SELECT_SPACING);
+		timer.restart();
+		for(u32 j=0; j < iterations.argument(); j++){
+			label_points = svg_font.find_all_fill_points(
+						canvas,
+						canvas.get_viewable_region(),
+						svg_font.m_pour_grid_size
+						);
+		}
+		timer.stop();
+		label_microseconds += timer.microseconds();
+
+		//how far the chosen points are from the nearest edge
+		svg_font.set_pour_select(SvgFontManager::POUR_SELECT_DISTANCE);
+		var::Vector<Point> distance_points = svg_font.find_all_fill_points(
+					canvas,
+					canvas.get_viewable_region(),
+					svg_font.m_pour_grid_size
+					);
+		DistanceMap distance_map(canvas);
+		for(u32 j=0; j < label_points.count(); j++){
+			spacing_clearance += distance_map.distance(label_points.at(j));
+		}
+		for(u32 j=0; j < distance_points.count(); j++){
+			distance_clearance += distance_map.distance(distance_points.at(j));
+			if( (j >= label_points.count()) || (label_points.at(j) != distance_points.at(j)) ){
+				moved_count++;
+			}
+		}
+
+		bool is_match = pour_points.count() == label_points.count();
+		for(u32 j=0; is_match && (j < label_points.count()); j++){
+			is_match = pour_points.at(j) == label_points.at(j);
+		}
+		if( is_match == false ){
+			mismatch_count++;
+		}
+
+		point_count += label_points.count();
+		shape_count++;
+	}
+
+	printer().key("shapes", "%ld", shape_count);
+	printer().key("pourPoints", "%ld", point_count);
+	printer().key("pour", "%ldus", pour_microseconds / iterations.argument());
+	printer().key("label", "%ldus", label_microseconds / iterations.argument());
+	printer().key(
+				"speedup",
+				"%0.2fx",
+				label_microseconds ?
+					pour_microseconds * 1.0f / label_microseconds :
+					0.0f
+					);
+	printer().key("mismatches", "%ld", mismatch_count);
+
+	printer().open_object("clearance");
+	printer().key(
+				"spacing",
+				"%0.2f",
+				point_count ? spacing_clearance / point_count : 0.0f
+				);
+	printer().key(
+				"distance",
+				"%0.2f",
+				point_count ? distance_clearance / point_count : 0.0f
+				);
+	printer().key("moved", "%ld", moved_count);
+	printer().close_object();
+
+	//working memory of the fill stage with and without the scratch pool
+	ScratchPool & pool = ScratchPool::get();
+	printer().open_object("scratch");
+	for(u32 is_pooled = 0; is_pooled < 2; is_pooled++){
+		pool.set_enabled(is_pooled != 0);
+		pool.reset_counts();
+		u32 microseconds = 0;
+		for(u32 i=0; i < path_list.count(); i++){
+			Bitmap canvas;
+			canvas.set_bits_per_pixel(1);
+			if( draw_outline(
+					 svg_font,
+					 path_list.at(i),
+					 view_box_list.at(i),
+					 units_per_em_list.at(i),
+					 canvas) < 0 ){
+				continue;
+			}
+
+			timer.restart();
+			for(u32 j=0; j < iterations.argument(); j++){
+				svg_font.find_all_fill_points(
+							canvas,
+							canvas.get_viewable_region(),
+							svg_font.m_pour_grid_size
+							);
+			}
+			timer.stop();
+			microseconds += timer.microseconds();
+		}
+
+		printer().open_object(is_pooled ? "pooled" : "unpooled");
+		printer().key("allocations", "%ld", pool.allocation_count());
+		printer().key(
+					"allocationsPerShape",
+					"%0.2f",
+					shape_count ?
+						pool.allocation_count() * 1.0f / (shape_count * iterations.argument()) :
+						0.0f
+						);
+		printer().key("bitmapRequests", "%ld", pool.acquire_count());
+		printer().key("time", "%ldus", microseconds / iterations.argument());
+		printer().close_object();
+	}
+	pool.set_enabled(true);
+	printer().close_object();
+
+	printer().close_object();
+	return 0;
+}
+
+var::Vector<FillPoint> Benchmark::find_fill_point_candidates_by_edge(
+		const sgfx::Bitmap & bitmap,
+		sg_size_t grid_size,
+		bool is_negative_fill
+		){
+	//the EdgeDetector search RowScanner replaced
+	var::Vector<FillPoint> result;
+	EdgeDetector edge_detector(bitmap);
+
+	for(sg_int_t y = 1; y < bitmap.height(); y+=grid_size){
+		edge_detector.set_region(
+					Region(
+						Point(0,y),
+						Area(bitmap.width(), 1)
+						)
+					);
+
+		Point end_point = edge_detector.region().end_point();
+
+		var::Vector<Array<Point, 2>> edges;
+		Array<Point, 2> edge_pair;
+
+		if( is_negative_fill ){
+			edge_pair.at(0) = Point(0,0);
+			edge_pair.at(1) = Point(0,0);
+			edges.push_back(edge_pair);
+		}
+
+		do {
+			edge_pair.at(0) = edge_detector.find_next();
+			edge_pair.at(1) = edge_detector.find_next();
+			if( edge_pair.at(0) != edge_detector.region().end_point() ){
+				edges.push_back(edge_pair);
+			}
+		} while( edge_pair.at(1) != end_point );
+
+		for(size_t i = 1; i < edges.count(); i+=2){
+			if( edges.at(i).at(0).x() != end_point.x() ){
+				result.push_back(
+							FillPoint(
+								Point(
+									(edges.at(i).at(0).x() - edges.at(i-1).at(1).x())/2 + edges.at(i-1).at(1).x(),
+									y
+									),
+								edges.at(i).at(0).x() - edges.at(i-1).at(1).x()
+								)
+							);
+			}
+		}
+	}
+
+	return result;
+}
+
+int Benchmark::run_row_scan(
+		fs::File::SourcePath input,
+		Iterations iterations
+		){
+
+	printer().open_object("benchmark.rows");
+	printer().key("iterations", "%ld", iterations.argument());
+
+	SvgFontManager svg_font;
+	svg_font.set_bits_per_pixel(1);
+	svg_font.set_canvas_size(128);
+	svg_font.set_pour_grid_size(3);
+
+	var::Vector<var::String> path_list;
+	var::Vector<var::String> view_box_list;
+	var::Vector<u32> units_per_em_list; //zero for icons
+	load_shape_list(input, svg_font, path_list, view_box_list, units_per_em_list);
+
+	//the fill canvas is 1bpp -- the same outlines at 8bpp exercise the vector kernels
+	const u8 bits_per_pixel_list[2] = {1, 8};
+	u32 kernel_microseconds[2][RowScanner::KERNEL_TOTAL] = {};
+	u32 kernel_mismatches[2][RowScanner::KERNEL_TOTAL] = {};
+	u32 row_count = 0;
+	u32 shape_count = 0;
+	u32 edge_microseconds = 0;
+	u32 run_microseconds = 0;
+	u32 candidate_mismatches = 0;
+	ClockTimer timer;
+	std::vector<RowScanner::run_t> runs;
+	std::vector<RowScanner::run_t> reference_runs;
+
+	for(u32 i=0; i < path_list.count(); i++){
+		Bitmap canvas;
+		canvas.set_bits_per_pixel(1);
+		if( draw_outline(
+				 svg_font,
+				 path_list.at(i),
+				 view_box_list.at(i),
+				 units_per_em_list.at(i),
+				 canvas) < 0 ){
+			continue;
+		}
+
+		Bitmap wide_canvas(canvas.area(), Bitmap::BitsPerPixel(8));
+		wide_canvas.clear();
+		wide_canvas.set_pen( Pen().set_color(0xff) );
+		for(sg_int_t y = 0; y < canvas.height(); y++){
+			for(sg_int_t x = 0; x < canvas.width(); x++){
+				if( canvas.get_pixel(Point(x,y)) ){
+					wide_canvas.draw_pixel(Point(x,y));
+				}
+			}
+		}
+
+		for(u32 depth = 0; depth < 2; depth++){
+			const Bitmap & bitmap = depth ? wide_canvas : canvas;
+			RowScanner reference(bitmap, RowScanner::KERNEL_PIXEL);
+			for(u32 kernel = 0; kernel < RowScanner::KERNEL_TOTAL; kernel++){
+				if( RowScanner::is_kernel_supported(
+						 (enum RowScanner::kernel)kernel,
+						 bits_per_pixel_list[depth]) == false ){
+					continue;
+				}
+
+				RowScanner scanner(bitmap, (enum RowScanner::kernel)kernel);
+				timer.restart();
+				for(u32 j=0; j < iterations.argument(); j++){
+					for(sg_int_t y = 0; y < bitmap.height(); y++){
+						scanner.scan(y, runs);
+					}
+				}
+				timer.stop();
+				kernel_microseconds[depth][kernel] += timer.microseconds();
+
+				for(sg_int_t y = 0; y < bitmap.height(); y++){
+					scanner.scan(y, runs);
+					reference.scan(y, reference_runs);
+					bool is_match = runs.size() == reference_runs.size();
+					for(u32 k=0; is_match && (k < runs.size()); k++){
+						is_match = (runs.at(k).start == reference_runs.at(k).start) &&
+								(runs.at(k).end == reference_runs.at(k).end);
+					}
+					if( is_match == false ){
+						kernel_mismatches[depth][kernel]++;
+					}
+				}
+			}
+		}
+		row_count += canvas.height();
+
+		//the candidate search as the fill stage uses it
+		for(u32 pass = 0; pass < 2; pass++){
+			var::Vector<FillPoint> edge_candidates;
+			timer.restart();
+			for(u32 j=0; j < iterations.argument(); j++){
+				edge_candidates = find_fill_point_candidates_by_edge(
+							canvas,
+							svg_font.m_pour_grid_size,
+							pass == 1
+							);
+			}
+			timer.stop();
+			edge_microseconds += timer.microseconds();
+
+			//the row table is built each time like the edge detector reads the canvas
+			var::Vector<FillPoint> run_candidates;
+			timer.restart();
+			for(u32 j=0; j < iterations.argument(); j++){
+				RunTable run_table(canvas);
+				run_candidates = svg_font.find_fill_point_candidates(
+							run_table,
+							canvas.get_viewable_region(),
+							svg_font.m_pour_grid_size,
+							pass == 1
+							);
+			}
+			timer.stop();
+			run_microseconds += timer.microseconds();
+
+			bool is_match = edge_candidates.count() == run_candidates.count();
+			for(u32 j=0; is_match && (j < run_candidates.count()); j++){
+				is_match = (edge_candidates.at(j).point() == run_candidates.at(j).point()) &&
+						(edge_candidates.at(j).spacing() == run_candidates.at(j).spacing());
+			}
+			if( is_match == false ){
+				candidate_mismatches++;
+			}
+		}
+
+		shape_count++;
+	}
+
+	printer().key("shapes", "%ld", shape_count);
+	printer().key("rows", "%ld", row_count);
+	for(u32 depth = 0; depth < 2; depth++){
+		printer().open_object(String().format("%dbpp", bits_per_pixel_list[depth]));
+		for(u32 kernel = 0; kernel < RowScanner::KERNEL_TOTAL; kernel++){
+			if( RowScanner::is_kernel_supported(
+					 (enum RowScanner::kernel)kernel,
+					 bits_per_pixel_list[depth]) == false ){
+				continue;
+			}
+			printer().open_object(RowScanner::get_kernel_name((enum RowScanner::kernel)kernel));
+			u32 microseconds = kernel_microseconds[depth][kernel];
+			printer().key(
+						"rowsPerSecond",
+						"%0.0f",
+						microseconds ?
+							row_count * 1000000.0f * iterations.argument() / microseconds :
+							0.0f
+							);
+			printer().key("mismatches", "%ld", kernel_mismatches[depth][kernel]);
+			printer().close_object();
+		}
+		printer().close_object();
+	}
+
+	printer().open_object("candidates");
+	printer().key("edge", "%ldus", edge_microseconds / iterations.argument());
+	printer().key("runs", "%ldus", run_microseconds / iterations.argument());
+	printer().key(
+				"speedup",
+				"%0.2fx",
+				run_microseconds ?
+					edge_microseconds * 1.0f / run_microseconds :
+					0.0f
+					);
+	printer().key("mismatches", "%ld", candidate_mismatches);
+	printer().close_object();
+
+	printer().close_object();
+	return 0;
+}
+
+int Benchmark::run_multires_search(
+		fs::File::SourcePath input,
+		Iterations iterations
+		){
+
+	printer().open_object("benchmark.multires");
+	printer().key("iterations", "%ld", iterations.argument());
+
+	SvgFontManager svg_font;
+	svg_font.set_bits_per_pixel(1);
+	svg_font.set_pour_grid_size(3);
+
+	var::Vector<var::String> path_list;
+	var::Vector<var::String> view_box_list;
+	var::Vector<u32> units_per_em_list; //zero for icons
+	load_shape_list(input, svg_font, path_list, view_box_list, units_per_em_list);
+
+	//the per-pixel maps grow with the area -- the runs mostly with the height
+	const u16 canvas_sizes[] = { 128, 512 };
+	ClockTimer timer;
+
+	for(u16 canvas_size: canvas_sizes){
+		svg_font.set_canvas_size(canvas_size);
+
+		u32 shape_count = 0;
+		u32 point_count = 0;
+		u32 full_microseconds = 0;
+		u32 multires_microseconds = 0;
+		u32 mismatch_count = 0;
+
+		for(u32 i=0; i < path_list.count(); i++){
+			Bitmap canvas;
+			canvas.set_bits_per_pixel(1);
+			if( draw_outline(
+					 svg_font,
+					 path_list.at(i),
+					 view_box_list.at(i),
+					 units_per_em_list.at(i),
+					 canvas) < 0 ){
+				continue;
+			}
+
+			var::Vector<Point> full_points;
+			svg_font.set_multires(false);
+			timer.restart();
+			for(u32 j=0; j < iterations.argument(); j++){
+				full_points = svg_font.find_all_fill_points(
+							canvas,
+							canvas.get_viewable_region(),
+							svg_font.m_pour_grid_size
+							);
+			}
+			timer.stop();
+			full_microseconds += timer.microseconds();
+
+			var::Vector<Point> multires_points;
+			svg_font.set_multires(true);
+			timer.restart();
+			for(u32 j=0; j < iterations.argument(); j++){
+				multires_points = svg_font.find_all_fill_points(
+							canvas,
+							canvas.get_viewable_region(),
+							svg_font.m_pour_grid_size
+							);
+			}
+			timer.stop();
+			multires_microseconds += timer.microseconds();
+
+			bool is_match = full_points.count() == multires_points.count();
+			for(u32 j=0; is_match && (j < full_points.count()); j++){
+				is_match = full_points.at(j) == multires_points.at(j);
+			}
+			if( is_match == false ){
+				mismatch_count++;
+			}
+
+			point_count += full_points.count();
+			shape_count++;
+		}
+
+		printer().open_object(String().format("canvas%d", canvas_size));
+		printer().key("shapes", "%ld", shape_count);
+		printer().key("pourPoints", "%ld", point_count);
+		printer().key("full", "%ldus", full_microseconds / iterations.argument());
+		printer().key("multires", "%ldus", multires_microseconds / iterations.argument());
+		printer().key(
+					"speedup",
+					"%0.2fx",
+					multires_microseconds ?
+						full_microseconds * 1.0f / multires_microseconds :
+						0.0f
+						);
+		printer().key("mismatches", "%ld", mismatch_count);
+		printer().close_object();
+	}
+
+	printer().close_object();
+	return 0;
+}
+
+int Benchmark::run_winding_test(
+		fs::File::SourcePath input,
+		Iterations iterations
+		){
+
+	printer().open_object("benchmark.winding");
+	printer().key("iterations", "%ld", iterations.argument());
+
+	SvgFontManager svg_font;
+	svg_font.set_bits_per_pixel(1);
+	svg_font.set_canvas_size(128);
+	svg_font.set_pour_grid_size(3);
+
+	var::Vector<var::String> path_list;
+	var::Vector<var::String> view_box_list;
+	var::Vector<u32> units_per_em_list; //zero for icons
+	load_shape_list(input, svg_font, path_list, view_box_list, units_per_em_list);
+
+	u32 shape_count = 0;
+	u32 candidate_count = 0;
+	u32 crossing_count = 0;
+	u32 raster_microseconds = 0;
+	u32 winding_microseconds = 0;
+	u32 disagreement_count = 0;
+	u32 mismatch_count = 0;
+	ClockTimer timer;
+
+	for(u32 i=0; i < path_list.count(); i++){
+		//icons are fitted after drawing so the path does not match the canvas
+		if( units_per_em_list.at(i) == 0 ){
+			continue;
+		}
+
+		Bitmap canvas;
+		canvas.set_bits_per_pixel(1);
+		if( draw_outline(
+				 svg_font,
+				 path_list.at(i),
+				 view_box_list.at(i),
+				 units_per_em_list.at(i),
+				 canvas) < 0 ){
+			continue;
+		}
+
+		const Region region = canvas.get_viewable_region();
+		PathGeometry geometry;
+		geometry.flatten(svg_font.process_svg_path(path_list.at(i)), region);
+
+		RunTable candidate_table(canvas);
+		var::Vector<FillPoint> candidates = svg_font.find_fill_point_candidates(
+					candidate_table,
+					region,
+					svg_font.m_pour_grid_size,
+					false
+					);
+		var::Vector<FillPoint> negative_candidates = svg_font.find_fill_point_candidates(
+					candidate_table,
+					region,
+					svg_font.m_pour_grid_size,
+					true
+					);
+		for(const auto & fill_point: negative_candidates){
+			candidates.push_back(fill_point);
+		}
+
+		//strokes counted on the row and column of each candidate
+		var::Vector<u8> raster_inside;
+		raster_inside.resize(candidates.count());
+		timer.restart();
+		for(u32 j=0; j < iterations.argument(); j++){
+			RunTable run_table(canvas);
+			for(u32 k=0; k < candidates.count(); k++){
+				raster_inside.at(k) =
+						SvgFontManager::is_fill_point(run_table, candidates.at(k).point(), region) != 0;
+			}
+		}
+		timer.stop();
+		raster_microseconds += timer.microseconds();
+
+		//the index is built per glyph so it is part of the time
+		var::Vector<u8> winding_inside;
+		winding_inside.resize(candidates.count());
+		timer.restart();
+		for(u32 j=0; j < iterations.argument(); j++){
+			WindingIndex winding_index(geometry, canvas.height());
+			for(u32 k=0; k < candidates.count(); k++){
+				winding_inside.at(k) = winding_index.is_inside(candidates.at(k).point());
+			}
+			crossing_count += winding_index.crossing_count();
+		}
+		timer.stop();
+		winding_microseconds += timer.microseconds();
+
+		for(u32 k=0; k < candidates.count(); k++){
+			if( raster_inside.at(k) != winding_inside.at(k) ){
+				disagreement_count++;
+			}
+		}
+
+		//pour points with each test
+		WindingIndex winding_index(geometry, canvas.height());
+		var::Vector<Point> raster_points = svg_font.find_all_fill_points(
+					canvas,
+					region,
+					svg_font.m_pour_grid_size
+					);
+		var::Vector<Point> winding_points = svg_font.find_all_fill_points(
+					canvas,
+					region,
+					svg_font.m_pour_grid_size,
+					&winding_index
+					);
+
+		bool is_match = raster_points.count() == winding_points.count();
+		for(u32 j=0; is_match && (j < raster_points.count()); j++){
+			is_match = raster_points.at(j) == winding_points.at(j);
+		}
+		if( is_match == false ){
+			mismatch_count++;
+		}
+
+		candidate_count += candidates.count();
+		shape_count++;
+	}
+
+	printer().key("shapes", "%ld", shape_count);
+	printer().key("candidates", "%ld", candidate_count);
+	printer().key(
+				"crossingsPerShape",
+				"%0.1f",
+				shape_count ?
+					crossing_count * 1.0f / (shape_count * iterations.argument()) :
+					0.0f
+					);
+	printer().key("raster", "%ldus", raster_microseconds / iterations.argument());
+	printer().key("winding", "%ldus", winding_microseconds / iterations.argument());
+	printer().key(
+				"speedup",
+				"%0.2fx",
+				winding_microseconds ?
+					raster_microseconds * 1.0f / winding_microseconds :
+					0.0f
+					);
+	printer().key("disagreements", "%ld", disagreement_count);
+	printer().key("pourMismatches", "%ld", mismatch_count);
+
+	printer().close_object();
+	return 0;
+}
+
+int Benchmark::run_pour_grid(
+		fs::File::SourcePath input,
+		Iterations iterations
+		){
+
+	printer().open_object("benchmark.grid");
+	printer().key("iterations", "%ld", iterations.argument());
+
+	SvgFontManager svg_font;
+	svg_font.set_bits_per_pixel(1);
+	svg_font.set_canvas_size(128);
+	svg_font.set_pour_grid_size(3);
+
+	var::Vector<var::String> path_list;
+	var::Vector<var::String> view_box_list;
+	var::Vector<u32> units_per_em_list; //zero for icons
+	load_shape_list(input, svg_font, path_list, view_box_list, units_per_em_list);
+
+	u32 shape_count = 0;
+	u32 reference_point_count = 0;
+	u32 fixed_point_count = 0;
+	u32 auto_point_count = 0;
+	u32 fixed_missed_count = 0;
+	u32 auto_missed_count = 0;
+	u32 fixed_row_count = 0;
+	u32 auto_row_count = 0;
+	u32 grid_total = 0;
+	u32 fixed_microseconds = 0;
+	u32 auto_microseconds = 0;
+	ClockTimer timer;
+	RegionMap region_map;
+
+	for(u32 i=0; i < path_list.count(); i++){
+		Bitmap canvas;
+		canvas.set_bits_per_pixel(1);
+		if( draw_outline(
+				 svg_font,
+				 path_list.at(i),
+				 view_box_list.at(i),
+				 units_per_em_list.at(i),
+				 canvas) < 0 ){
+			continue;
+		}
+
+		//every row is searched for the reference
+		svg_font.set_pour_grid_auto(false);
+		var::Vector<Point> reference_points = svg_font.find_all_fill_points(
+					canvas,
+					canvas.get_viewable_region(),
+					1
+					);
+
+		var::Vector<Point> fixed_points;
+		timer.restart();
+		for(u32 j=0; j < iterations.argument(); j++){
+			fixed_points = svg_font.find_all_fill_points(
+						canvas,
+						canvas.get_viewable_region(),
+						svg_font.m_pour_grid_size
+						);
+		}
+		timer.stop();
+		fixed_microseconds += timer.microseconds();
+
+		var::Vector<Point> auto_points;
+		svg_font.set_pour_grid_auto(true);
+		timer.restart();
+		for(u32 j=0; j < iterations.argument(); j++){
+			auto_points = svg_font.find_all_fill_points(
+						canvas,
+						canvas.get_viewable_region(),
+						svg_font.m_pour_grid_size
+						);
+		}
+		timer.stop();
+		auto_microseconds += timer.microseconds();
+
+		//rows the candidate search visits (starting at row 1)
+		region_map.calculate(canvas, false);
+		sg_size_t region_height;
+		sg_size_t grid = SvgFontManager::select_pour_grid_size(region_map, region_height);
+		const u32 search_height = canvas.height() > 1 ? canvas.height() - 1 : 0;
+		fixed_row_count += (search_height + svg_font.m_pour_grid_size - 1) / svg_font.m_pour_grid_size;
+		auto_row_count += (search_height + grid - 1) / grid;
+		grid_total += grid;
+
+		//a missed region gets no pour point
+		if( fixed_points.count() < reference_points.count() ){
+			fixed_missed_count++;
+		}
+		if( auto_points.count() < reference_points.count() ){
+			auto_missed_count++;
+		}
+
+		reference_point_count += reference_points.count();
+		fixed_point_count += fixed_points.count();
+		auto_point_count += auto_points.count();
+		shape_count++;
+	}
+
+	printer().key("shapes", "%ld", shape_count);
+	printer().key("pourPoints", "%ld", reference_point_count);
+	printer().key(
+				"grid",
+				"%0.2f",
+				shape_count ? grid_total * 1.0f / shape_count : 0.0f
+				);
+
+	printer().open_object("fixed");
+	printer().key("grid", "%d", svg_font.m_pour_grid_size);
+	printer().key("rows", "%ld", fixed_row_count);
+	printer().key("pourPoints", "%ld", fixed_point_count);
+	printer().key("missed", "%ld", fixed_missed_count);
+	printer().key("time", "%ldus", fixed_microseconds / iterations.argument());
+	printer().close_object();
+
+	printer().open_object("auto");
+	printer().key("rows", "%ld", auto_row_count);
+	printer().key("pourPoints", "%ld", auto_point_count);
+	printer().key("missed", "%ld", auto_missed_count);
+	printer().key("time", "%ldus", auto_microseconds / iterations.argument());
+	printer().close_object();
+
+	printer().key(
+				"speedup",
+				"%0.2fx",
+				auto_microseconds ?
+					fixed_microseconds * 1.0f / auto_microseconds :
+					0.0f
+					);
+
+	printer().close_object();
+	return 0;
+}
+
+int Benchmark::run_flattening(
+		fs::File::SourcePath input,
+		Iterations iterations
+		){
+
+	printer().open_object("benchmark.flatness");
+	printer().key("iterations", "%ld", iterations.argument());
+
+	SvgFontManager svg_font;
+	svg_font.set_bits_per_pixel(1);
+	svg_font.set_canvas_size(128);
+
+	var::Vector<var::String> path_list;
+	var::Vector<var::String> view_box_list;
+	var::Vector<u32> units_per_em_list; //zero for icons
+	load_shape_list(input, svg_font, path_list, view_box_list, units_per_em_list);
+
+	//the first tolerance is the reference the others are compared with
+	const float tolerance_list[] = {
+		PathGeometry::MINIMUM_TOLERANCE,
+		PathGeometry::DEFAULT_TOLERANCE,
+		0.5f,
+		1.0f,
+		2.0f
+	};
+	enum {
+		TOLERANCE_TOTAL = sizeof(tolerance_list) / sizeof(float)
+	};
+
+	u32 shape_count = 0;
+	u32 curve_count = 0;
+	u32 segment_count[TOLERANCE_TOTAL] = {0};
+	u32 microseconds[TOLERANCE_TOTAL] = {0};
+	u32 diff_count[TOLERANCE_TOTAL] = {0};
+	u32 pixel_count = 0;
+	ClockTimer timer;
+
+	for(u32 i=0; i < path_list.count(); i++){
+		//icons are fitted after drawing so the path does not match the canvas
+		if( units_per_em_list.at(i) == 0 ){
+			continue;
+		}
+
+		Bitmap outline;
+		outline.set_bits_per_pixel(1);
+		if( draw_outline(
+				 svg_font,
+				 path_list.at(i),
+				 view_box_list.at(i),
+				 units_per_em_list.at(i),
+				 outline) < 0 ){
+			continue;
+		}
+
+		const Region region = outline.get_viewable_region();
+		var::Vector<sg_vector_path_description_t> elements =
+				svg_font.process_svg_path(path_list.at(i));
+
+		Bitmap reference;
+		reference.set_bits_per_pixel(1);
+		reference.allocate(outline.area());
+		for(u32 t=0; t < TOLERANCE_TOTAL; t++){
+			PathGeometry geometry;
+			geometry.set_tolerance(tolerance_list[t]);
+
+			//flattening and filling is what the tolerance changes
+			Bitmap canvas;
+			canvas.set_bits_per_pixel(1);
+			canvas.allocate(outline.area());
+			canvas.set_pen(
+						Pen().set_color(0xffffffff)
+						.set_thickness(1)
+						.set_fill(true)
+						);
+			timer.restart();
+			for(u32 j=0; j < iterations.argument(); j++){
+				canvas.clear();
+				geometry.flatten(elements, region);
+				ScanlineRasterizer(geometry).fill(canvas);
+			}
+			timer.stop();
+			microseconds[t] += timer.microseconds();
+			segment_count[t] += geometry.segments().count();
+
+			if( t == 0 ){
+				reference.draw_bitmap(Point(0,0), canvas);
+				curve_count += geometry.curve_count();
+			}
+
+			//pixels set at one tolerance and not the other
+			for(sg_int_t y = 0; y < canvas.height(); y++){
+				for(sg_int_t x = 0; x < canvas.width(); x++){
+					bool is_reference = reference.get_pixel(Point(x,y)) != 0;
+					bool is_set = canvas.get_pixel(Point(x,y)) != 0;
+					if( t == 0 && is_set ){ pixel_count++; }
+					if( is_reference != is_set ){ diff_count[t]++; }
+				}
+			}
+		}
+
+		shape_count++;
+	}
+
+	printer().key("shapes", "%ld", shape_count);
+	printer().key("curves", "%ld", curve_count);
+	printer().key("pixels", "%ld", pixel_count);
+
+	for(u32 t=0; t < TOLERANCE_TOTAL; t++){
+		printer().open_object(String().format("%0.2f", tolerance_list[t]));
+		printer().key("segments", "%ld", segment_count[t]);
+		printer().key(
+					"segmentsPerCurve",
+					"%0.2f",
+					curve_count ? segment_count[t] * 1.0f / curve_count : 0.0f
+					);
+		printer().key("time", "%ldus", microseconds[t] / iterations.argument());
+		printer().key("changedPixels", "%ld", diff_count[t]);
+		printer().close_object();
+	}
+
+	printer().close_object();
+	return 0;
+}
+
+int Benchmark::draw_outline(
+		SvgFontManager & svg_font,
+		const var::String & d,
+		const var::String & view_box,
+		u32 units_per_em,
+		sgfx::Bitmap & canvas
+		){
+	//the same drawing convert_svg_path() does before it looks for fill points
+	bool is_icon = units_per_em == 0;
+	set_shape_bounds(svg_font, view_box, units_per_em);
+
+	var::Vector<sg_vector_path_description_t> elements =
+			svg_font.process_svg_path(d);
+	if( elements.count() == 0 ){
+		return -1;
+	}
+
+	canvas.allocate(svg_font.m_canvas_dimensions);
+	canvas.set_pen(
+				Pen().set_color(0xffffffff)
+				.set_thickness(1)
+				.set_fill(true)
+				);
+	VectorMap map;
+	map.calculate_for_bitmap(canvas);
+	sgfx::VectorPath vector_path;
+	vector_path << elements << canvas.get_viewable_region();
+	canvas.clear();
+
+	if( is_icon ){
+		svg_font.fit_icon_to_canvas(canvas, vector_path, map, svg_font.m_aspect_ratio);
+	} else {
+		PathGeometry line_geometry;
+		line_geometry.set_tolerance(svg_font.calculate_flatness());
+		var::Vector<sg_vector_path_description_t> lines =
+				line_geometry.flatten_to_lines(elements, canvas.get_viewable_region());
+		sgfx::VectorPath line_path;
+		line_path << lines << canvas.get_viewable_region();
+		sgfx::Vector::draw(canvas, line_path, map);
+	}
+	return 0;
+}
+
+int Benchmark::run_icon_fit(fs::File::SourcePath input){
+	var::Vector<var::String> file_list = get_svg_file_list(input.argument());
+
+	printer().open_object("benchmark.fit");
+
+	SvgFontManager svg_font;
+	svg_font.set_bits_per_pixel(1);
+	svg_font.set_canvas_size(128);
+
+	u32 icon_count = 0;
+	u32 mismatch_count = 0;
+	u32 max_difference = 0;
+
+	//the fit uses the active region of a trial render -- compare it with
+	//the region from the analytic path bounds
+	for(const auto & file_path: file_list){
+		String name;
+		String view_box;
+		var::Vector<String> drawing_paths;
+		if( (svg_font.read_svg_icon(file_path, name, view_box, drawing_paths) <= 0) ||
+			 view_box.is_empty() ){
+			continue;
+		}
+
+		set_shape_bounds(svg_font, view_box, 0);
+
+		var::Vector<sg_vector_path_description_t> elements;
+		enum SvgFontManager::item_status status = SvgFontManager::ITEM_STATUS_OK;
+		for(const auto & d: drawing_paths){
+			var::Vector<sg_vector_path_description_t> path_elements =
+					svg_font.process_svg_path(d.cstring(), d.length(), &status);
+			for(const auto & element: path_elements){
+				elements.push_back(element);
+			}
+		}
+
+		if( (status != SvgFontManager::ITEM_STATUS_OK) || (elements.count() == 0) ){
+			continue;
+		}
+
+		Bitmap canvas;
+		canvas.set_bits_per_pixel(1);
+		canvas.allocate(svg_font.m_canvas_dimensions);
+		canvas.clear();
+		canvas.set_pen(
+					Pen().set_color(0xffffffff)
+					.set_thickness(1)
+					.set_fill(true)
+					);
+
+		const Region full_region = canvas.get_viewable_region();
+		VectorMap map;
+		map.calculate_for_region(full_region);
+		map.set_rotation(0);
+		sgfx::VectorPath vector_path;
+		vector_path << elements << full_region;
+		sgfx::Vector::draw(canvas, vector_path, map);
+		const Region rendered_region = canvas.calculate_active_region();
+
+		Region analytic_region;
+		PathGeometry::bounds_t bounds;
+		if( PathGeometry::calculate_bounds(elements, bounds) ){
+			analytic_region = PathGeometry::map_bounds(bounds, full_region);
+		}
+
+		const s32 difference[4] = {
+			rendered_region.point().x() - analytic_region.point().x(),
+			rendered_region.point().y() - analytic_region.point().y(),
+			(s32)rendered_region.area().width() - analytic_region.area().width(),
+			(s32)rendered_region.area().height() - analytic_region.area().height()
+		};
+
+		u32 icon_difference = 0;
+		for(u32 i=0; i < 4; i++){
+			u32 value = difference[i] < 0 ? -1*difference[i] : difference[i];
+			icon_difference = value > icon_difference ? value : icon_difference;
+		}
+
+		if( icon_difference ){
+			mismatch_count++;
+			printer().debug(
+						"%s rendered %d,%d %dx%d analytic %d,%d %dx%d",
+						FileInfo::name(file_path).cstring(),
+						rendered_region.point().x(),
+						rendered_region.point().y(),
+						rendered_region.area().width(),
+						rendered_region.area().height(),
+						analytic_region.point().x(),
+						analytic_region.point().y(),
+						analytic_region.area().width(),
+						analytic_region.area().height()
+						);
+		}
+		max_difference = icon_difference > max_difference ? icon_difference : max_difference;
+		icon_count++;
+	}
+
+	printer().key("icons", "%ld", icon_count);
+	printer().key("mismatches", "%ld", mismatch_count);
+	printer().key("maxDifference", "%ldpx", max_difference);
+	printer().close_object();
+	return 0;
+}
+
+void Benchmark::set_shape_bounds(
+		SvgFontManager & svg_font,
+		const var::String & view_box,
+		u32 units_per_em
+		){
+	//settings process_font_face() or process_svg_icon() would apply
+	bool is_icon = units_per_em == 0;
+	svg_font.set_flip_y(is_icon == false);
+	svg_font.m_bounds = svg_font.parse_bounds(view_box);
+	if( is_icon ){
+		svg_font.m_aspect_ratio = svg_font.m_bounds.width() * 1.0f / svg_font.m_bounds.height();
+		svg_font.m_canvas_dimensions = Area(svg_font.m_canvas_size, svg_font.m_canvas_size);
+		svg_font.m_scale = (SG_MAP_MAX*1.0f) / svg_font.m_bounds.area().maximum_dimension();
+	} else {
+		svg_font.m_canvas_dimensions =
+				svg_font.calculate_canvas_dimension(
+					svg_font.m_bounds,
+					svg_font.m_canvas_size
+					);
+		svg_font.m_scale = (SG_MAP_MAX*1.0f) / units_per_em;
+		svg_font.m_canvas_origin =
+				svg_font.calculate_canvas_origin(
+					svg_font.m_bounds,
+					svg_font.m_canvas_dimensions
+					);
+		svg_font.m_point_size =
+				1.0f * svg_font.m_canvas_dimensions.height() * units_per_em /
+				svg_font.m_bounds.area().height() * SG_MAP_MAX / (SG_MAX);
+	}
+}
+
+int Benchmark::run_fill_comparison(
+		fs::File::SourcePath input,
+		Iterations iterations
+		){
+
+	var::Vector<var::String> font_list = get_svg_file_list(input.argument());
+
+	printer().open_object("benchmark.fill");
+	printer().key("iterations", "%ld", iterations.argument());
+
+	for(const auto & font_path: font_list){
+		JsonObject font =
+				JsonDocument().load(
+					JsonDocument::XmlFilePath(font_path)
+					).to_object()
+				.at("svg").to_object()
+				.at("defs").to_object()
+				.at("font").to_object();
+
+		JsonObject font_face = font.at("font-face").to_object();
+		JsonArray glyphs = font.at("glyph").to_array();
+		u32 units_per_em = font_face.at("@units-per-em").to_string().to_integer();
+		String bbox = font_face.at("@bbox").to_string();
+
+		if( (glyphs.count() == 0) || (units_per_em == 0) || bbox.is_empty() ){
+			printer().warning("no glyphs found in %s", font_path.cstring());
+			continue;
+		}
+
+		//final glyphs are compared at 4 bpp (where coverage matters)
+		SvgFontManager svg_font;
+		svg_font.set_bits_per_pixel(4);
+		svg_font.set_canvas_size(128);
+		svg_font.set_pour_grid_size(3);
+		svg_font.set_downsample_factor(Area(4,4));
+		svg_font.set_show_canvas(false);
+		set_shape_bounds(svg_font, bbox, units_per_em);
+
+		u32 glyph_count = 0;
+		u32 pour_microseconds = 0;
+		u32 scanline_microseconds = 0;
+		u32 downsample_microseconds = 0;
+		u32 coverage_microseconds = 0;
+		u32 pixel_count = 0;
+		u32 diff_count = 0;
+		u32 level_diff = 0;
+		u32 level_count = 0;
+		ClockTimer timer;
+
+		printer().open_object(FileInfo::name(font_path));
+		for(u32 i=0; i < glyphs.count(); i++){
+			JsonObject glyph = glyphs.at(i).to_object();
+			String d = glyph.at("@d").to_string();
+			if( d.is_empty() ){
+				continue;
+			}
+
+			//both fills get the same canvas so the pixels line up
+			Point canvas_offset;
+			Bitmap pour_canvas;
+			pour_canvas.set_bits_per_pixel(1);
+			svg_font.set_fill(SvgFontManager::FILL_POUR);
+			timer.restart();
+			for(u32 j=0; j < iterations.argument(); j++){
+				svg_font.convert_svg_path(
+							pour_canvas,
+							d.cstring(),
+							d.length(),
+							svg_font.m_canvas_dimensions,
+							svg_font.m_pour_grid_size,
+							false,
+							canvas_offset
+							);
+			}
+			timer.stop();
+			u32 pour_time = timer.microseconds() / iterations.argument();
+
+			Bitmap scanline_canvas;
+			scanline_canvas.set_bits_per_pixel(1);
+			svg_font.set_fill(SvgFontManager::FILL_SCANLINE);
+			timer.restart();
+			for(u32 j=0; j < iterations.argument(); j++){
+				svg_font.convert_svg_path(
+							scanline_canvas,
+							d.cstring(),
+							d.length(),
+							svg_font.m_canvas_dimensions,
+							svg_font.m_pour_grid_size,
+							false,
+							canvas_offset
+							);
+			}
+			timer.stop();
+			u32 scanline_time = timer.microseconds() / iterations.argument();
+
+			//pixels set by one fill and not the other
+			u32 glyph_pixels = 0;
+			u32 glyph_diff = 0;
+			for(sg_int_t y = 0; y < pour_canvas.height(); y++){
+				for(sg_int_t x = 0; x < pour_canvas.width(); x++){
+					bool is_pour = pour_canvas.get_pixel(Point(x,y)) != 0;
+					bool is_scanline = scanline_canvas.get_pixel(Point(x,y)) != 0;
+					if( is_pour ){ glyph_pixels++; }
+					if( is_pour != is_scanline ){ glyph_diff++; }
+				}
+			}
+
+			//final glyph: full canvas plus downsample versus direct coverage
+			SvgFontManager::glyph_job_t job;
+			job.ascii_value = 0;
+			job.x_advance = 0;
+			SvgFontManager::glyph_result_t downsample_result;
+			SvgFontManager::glyph_result_t coverage_result;
+
+			svg_font.set_fill(SvgFontManager::FILL_SCANLINE);
+			timer.restart();
+			for(u32 j=0; j < iterations.argument(); j++){
+				svg_font.rasterize_glyph(job, d.cstring(), d.length(), downsample_result);
+			}
+			timer.stop();
+			u32 downsample_time = timer.microseconds() / iterations.argument();
+
+			svg_font.set_fill(SvgFontManager::FILL_COVERAGE);
+			timer.restart();
+			for(u32 j=0; j < iterations.argument(); j++){
+				svg_font.rasterize_glyph(job, d.cstring(), d.length(), coverage_result);
+			}
+			timer.stop();
+			u32 coverage_time = timer.microseconds() / iterations.argument();
+
+			//sum of the differences in gray level where the bitmaps overlap
+			const Bitmap & downsample_bitmap = downsample_result.bitmap;
+			const Bitmap & coverage_bitmap = coverage_result.bitmap;
+			for(sg_int_t y = 0; (y < downsample_bitmap.height()) && (y < coverage_bitmap.height()); y++){
+				for(sg_int_t x = 0; (x < downsample_bitmap.width()) && (x < coverage_bitmap.width()); x++){
+					s32 a = downsample_bitmap.get_pixel(Point(x,y));
+					s32 b = coverage_bitmap.get_pixel(Point(x,y));
+					level_diff += a > b ? a - b : b - a;
+					level_count++;
+				}
+			}
+
+			printer().key(
+						String().format("glyph-%ld", i),
+						"%s pour %ldus scanline %ldus diff %ld/%ld downsample %ldus coverage %ldus",
+						glyph.at("@unicode").to_string().cstring(),
+						pour_time,
+						scanline_time,
+						glyph_diff,
+						glyph_pixels,
+						downsample_time,
+						coverage_time
+						);
+
+			pour_microseconds += pour_time;
+			scanline_microseconds += scanline_time;
+			downsample_microseconds += downsample_time;
+			coverage_microseconds += coverage_time;
+			pixel_count += glyph_pixels;
+			diff_count += glyph_diff;
+			glyph_count++;
+		}
+
+		printer().key("glyphs", "%ld", glyph_count);
+		printer().key("pour", "%ldus", pour_microseconds);
+		printer().key("scanline", "%ldus", scanline_microseconds);
+		printer().key(
+					"speedup",
+					"%0.2fx",
+					scanline_microseconds ?
+						pour_microseconds * 1.0f / scanline_microseconds :
+						0.0f
+						);
+		printer().key(
+					"pixelDiff",
+					"%ld/%ld (%0.2f%%)",
+					diff_count,
+					pixel_count,
+					pixel_count ? diff_count * 100.0f / pixel_count : 0.0f
+					);
+		printer().key("downsample", "%ldus", downsample_microseconds);
+		printer().key("coverage", "%ldus", coverage_microseconds);
+		printer().key(
+					"coverageSpeedup",
+					"%0.2fx",
+					coverage_microseconds ?
+						downsample_microseconds * 1.0f / coverage_microseconds :
+						0.0f
+						);
+		//per glyph canvas that coverage no longer allocates
+		printer().key(
+					"canvasBytes",
+					"%ld",
+					(u32)svg_font.m_canvas_dimensions.width() *
+					svg_font.m_canvas_dimensions.height() *
+					svg_font.bits_per_pixel() / 8
+					);
+		printer().key(
+					"meanLevelDiff",
+					"%0.3f",
+					level_count ? level_diff * 1.0f / level_count : 0.0f
+					);
+		printer().close_object();
+	}
+
+	printer().close_object();
+	return 0;
+}
@@ -0,0 +1,147 @@
+/*! \file */ //Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+
+#ifndef BENCHMARK_HPP_
+#define BENCHMARK_HPP_
+
+#include <sapi/sys.hpp>
+#include <sapi/var.hpp>
+#include <sapi/fs.hpp>
+#include <sapi/sgfx.hpp>
+#include "ApplicationPrinter.hpp"
+
+class FillPoint;
+class SvgFontManager;
+
+/*! \details Timing harness used with `--action=benchmark`.
+ *
+ * Each benchmark compares an optimized stage of the
+ * conversion pipeline with the implementation it replaced.
+ *
+ * ```
+ * fonttool --action=benchmark --benchmark=path --input=fonts
+ * fonttool --action=benchmark --benchmark=icons --input=icons/svgs/solid
+ * fonttool --action=benchmark --benchmark=regions --input=fonts/robotoc-l.svg
+ * fonttool --action=benchmark --benchmark=regions --input=icons/svgs/solid
+ * fonttool --action=benchmark --benchmark=rows --input=fonts/robotoc-l.svg
+ * fonttool --action=benchmark --benchmark=fill --input=fonts/robotoc-l.svg
+ * fonttool --action=benchmark --benchmark=multires --input=fonts/robotoc-l.svg
+ * fonttool --action=benchmark --benchmark=winding --input=fonts/robotoc-l.svg
+ * fonttool --action=benchmark --benchmark=grid --input=fonts/opensans-l.svg
+ * fonttool --action=benchmark --benchmark=flatness --input=fonts/robotoc-l.svg
+ * ```
+ *
+ */
+class Benchmark : public ApplicationPrinter {
+public:
+
+	using Iterations = arg::Argument<u32, struct BenchmarkIterationsTag>;
+
+	static int run(
+			const var::String & name,
+			fs::File::SourcePath input,
+			Iterations iterations
+			);
+
+private:
+	static int run_path_parser(
+			fs::File::SourcePath input,
+			Iterations iterations
+			);
+
+	static int run_icon_conversion(
+			fs::File::SourcePath input
+			);
+
+	static int run_code_point_index(Iterations iterations);
+
+	static int run_region_grouping(
+			fs::File::SourcePath input,
+			Iterations iterations
+			);
+
+	static var::Vector<int> group_by_pour(
+			const sgfx::Bitmap & bitmap,
+			const var::Vector<FillPoint> & fill_points
+			);
+
+	static var::Vector<sgfx::Point> find_fill_points_by_pour(
+			SvgFontManager & svg_font,
+			const sgfx::Bitmap & bitmap
+			);
+
+	static int run_row_scan(
+			fs::File::SourcePath input,
+			Iterations iterations
+			);
+
+	static int run_multires_search(
+			fs::File::SourcePath input,
+			Iterations iterations
+			);
+
+	static int run_winding_test(
+			fs::File::SourcePath input,
+			Iterations iterations
+			);
+
+	static int run_pour_grid(
+			fs::File::SourcePath input,
+			Iterations iterations
+			);
+
+	static int run_flattening(
+			fs::File::SourcePath input,
+			Iterations iterations
+			);
+
+	static int run_icon_fit(fs::File::SourcePath input);
+
+	static var::Vector<FillPoint> find_fill_point_candidates_by_edge(
+			const sgfx::Bitmap & bitmap,
+			sg_size_t grid_size,
+			bool is_negative_fill
+			);
+
+	static void load_shape_list(
+			fs::File::SourcePath input,
+			SvgFontManager & svg_font,
+			var::Vector<var::String> & path_list,
+			var::Vector<var::String> & view_box_list,
+			var::Vector<u32> & units_per_em_list
+			);
+
+	static sg_size_t get_y_fill_spacing_by_scan(
+			const sgfx::Bitmap & bitmap,
+			sgfx::Point point
+			);
+
+	static int run_fill_comparison(
+			fs::File::SourcePath input,
+			Iterations iterations
+			);
+
+	static void set_shape_bounds(
+			SvgFontManager & svg_font,
+			const var::String & view_box,
+			u32 units_per_em
+			);
+
+	static int draw_outline(
+			SvgFontManager & svg_font,
+			const var::String & d,
+			const var::String & view_box,
+			u32 units_per_em,
+			sgfx::Bitmap & canvas
+			);
+
+	static var::Vector<var::String> get_svg_file_list(const var::String & path);
+	static bool is_file_equal(const var::String & a, const var::String & b);
+	static bool is_element_equal(
+			const sg_vector_path_description_t & a,
+			const sg_vector_path_description_t & b
+			);
+	static bool is_implicit_line(const var::String & d);
+};
+
+#endif /* BENCHMARK_HPP_ */
@@ -1,4 +1,75 @@
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+#include <sapi/chrono.hpp>
 #include "BmpFontGenerator.hpp"
+#include "AtlasPacker.hpp"
+
+namespace {
+
+//tallest characters first -- ties keep the character order
+//duplicate bitmaps are not packed (they share the location of the source)
+std::vector<u32> get_pack_order(
+		const var::Vector<sg_font_char_t> & character_list,
+		const var::Vector<u32> & source_list
+		){
+	std::vector<u32> order;
+	for(u32 i = 0; i < character_list.count(); i++){
+		if( character_list.at(i).width &&
+			 character_list.at(i).height &&
+			 (source_list.at(i) == i) ){
+			order.push_back(i);
+		}
+	}
+
+	std::sort(
+				order.begin(),
+				order.end(),
+				[&character_list](u32 a, u32 b){
+		const sg_font_char_t & first = character_list.at(a);
+		const sg_font_char_t & second = character_list.at(b);
+		if( first.height != second.height ){
+			return first.height > second.height;
+		}
+		if( first.width != second.width ){
+			return first.width > second.width;
+		}
+		return a < b;
+	}
+	);
+
+	return order;
+}
+
+//FNV-1a over the dimensions and the pixel data
+u32 hash_bitmap(const Bitmap & bitmap){
+	u32 hash = 2166136261UL;
+	const u32 header[3] = {
+		(u32)bitmap.width(),
+		(u32)bitmap.height(),
+		(u32)bitmap.bits_per_pixel()
+	};
+	const u8 * bytes = (const u8*)header;
+	for(u32 i=0; i < sizeof(header); i++){
+		hash = (hash ^ bytes[i]) * 16777619UL;
+	}
+	bytes = (const u8*)bitmap.data();
+	for(u32 i=0; i < bitmap.size(); i++){
+		hash = (hash ^ bytes[i]) * 16777619UL;
+	}
+	return hash;
+}
+
+bool is_bitmap_equal(const Bitmap & a, const Bitmap & b){
+	return (a.width() == b.width()) &&
+			(a.height() == b.height()) &&
+			(a.bits_per_pixel() == b.bits_per_pixel()) &&
+			(a.size() == b.size()) &&
+			(memcmp(a.data(), b.data(), a.size()) == 0);
+}
+
+}
 
 BmpFontGenerator::BmpFontGenerator(){
 	m_is_ascii = false;
@@ -67,11 +138,36 @@ int BmpFontGenerator::generate_font_file(const String & destination){
 	header.size = sizeof(header) + header.character_count*sizeof(sg_font_char_t) + header.kerning_pair_count*sizeof(sg_font_kerning_pair_t);
 	header.canvas_width = header.max_word_width*2*32;
 	header.canvas_height = header.max_height*3/2;
+
+	find_duplicate_bitmaps();
+
+	//duplicates share the bitmap of the first copy so only that one is packed
+	u32 packed_area = 0;
+	for(u32 i=0; i < character_list().count(); i++){
+		if( (i < m_bitmap_source_list.count()) && (m_bitmap_source_list.at(i) == i) ){
+			packed_area += character_list().at(i).width*character_list().at(i).height;
+		}
+	}
+
+	if( packer() == PACKER_SKYLINE ){
+		optimize_canvas_dimensions(header);
+	}
 	
 	var::Vector<Bitmap> master_canvas_list = build_master_canvas(header);
 	if( master_canvas_list.count() == 0 ){
 		return -1;
 	}
+
+	u32 canvas_bytes = master_canvas_list.count() *
+			calculate_canvas_size(Area(header.canvas_width, header.canvas_height));
+	printer().info(
+				"%d master canvases %dx%d (%d bytes) fill ratio %0.2f",
+				master_canvas_list.count(),
+				header.canvas_width,
+				header.canvas_height,
+				canvas_bytes,
+				packed_area * 1.0f / (master_canvas_list.count() * header.canvas_width * header.canvas_height)
+				);
 	
 	for(u32 i=0; i < master_canvas_list.count(); i++){
 		printer().open_object(String().format("master canvas %d", i), Printer::DEBUG);
@@ -362,38 +458,42 @@ var::Vector<Bitmap> BmpFontGenerator::build_master_canvas(
 		return master_canvas_list;
 	}
 	
+	ClockTimer timer;
+	timer.start();
+	int result;
+	if( packer() == PACKER_SCAN ){
+		result = pack_scan(master_canvas_list, master_canvas);
+	} else {
+		result = pack_skyline(master_canvas_list, master_canvas);
+	}
+	timer.stop();
+
+	if( result < 0 ){
+		return var::Vector<Bitmap>();
+	}
+
+	//duplicates share the atlas location of the first identical bitmap
 	for(u32 i = 0; i < character_list().count(); i++){
-		//find a place for the character on the master bitmap
-		Region region;
-		Area character_dim(character_list().at(i).width, character_list().at(i).height);
-		
-		if( character_dim.width() && character_dim.height() ){
-			do {
-				
-				for(u32 j = 0; j < master_canvas_list.count(); j++){
-					region = find_space_on_canvas(master_canvas_list.at(j), bitmap_list().at(i).area());
-					if( region.is_valid() ){
-						printer().debug("allocate %d (%c) to master canvas %d at %d,%d",
-											 character_list().at(i).id,
-											 character_list().at(i).id,
-											 j,
-											 region.x(), region.y());
-						character_list().at(i).canvas_x = region.x();
-						character_list().at(i).canvas_y = region.y();
-						character_list().at(i).canvas_idx = j;
-						break;
-					}
-				}
-				
-				if( region.is_valid() == false ){
-					master_canvas_list.push_back(master_canvas);
-				}
-				
-			} while( !region.is_valid() );
+		u32 source = m_bitmap_source_list.at(i);
+		if( source != i ){
+			character_list().at(i).canvas_x = character_list().at(source).canvas_x;
+			character_list().at(i).canvas_y = character_list().at(source).canvas_y;
+			character_list().at(i).canvas_idx = character_list().at(source).canvas_idx;
 		}
 	}
-	
+
+	printer().info(
+				"packed %d characters on %d master canvases in %ldus (%s)",
+				character_list().count(),
+				master_canvas_list.count(),
+				timer.microseconds(),
+				packer() == PACKER_SCAN ? "scan" : "skyline"
+				);
+
 	for(u32 i = 0; i < character_list().count(); i++){
+		if( m_bitmap_source_list.at(i) != i ){
+			continue;
+		}
 		Point p(character_list().at(i).canvas_x, character_list().at(i).canvas_y);
 		master_canvas_list.at(character_list().at(i).canvas_idx).draw_bitmap(p, bitmap_list().at(i));
 	}
@@ -506,6 +606,222 @@ int BmpFontGenerator::import_map(const String & map){
 	return 0;
 }
 
+u32 BmpFontGenerator::find_duplicate_bitmaps(){
+	//maps a bitmap hash to the characters that have it
+	std::unordered_map<u32, std::vector<u32>> hash_map;
+	u32 duplicate_count = 0;
+	u32 bytes_saved = 0;
+
+	m_bitmap_source_list.resize(bitmap_list().count());
+	for(u32 i = 0; i < bitmap_list().count(); i++){
+		m_bitmap_source_list.at(i) = i;
+
+		const Bitmap & bitmap = bitmap_list().at(i);
+		if( (bitmap.width() == 0) || (bitmap.height() == 0) ){
+			continue;
+		}
+
+		//the hash only finds candidates -- the pixels must match exactly
+		std::vector<u32> & candidates = hash_map[hash_bitmap(bitmap)];
+		for(const auto candidate: candidates){
+			if( is_bitmap_equal(bitmap_list().at(candidate), bitmap) ){
+				m_bitmap_source_list.at(i) = candidate;
+				break;
+			}
+		}
+
+		if( m_bitmap_source_list.at(i) == i ){
+			candidates.push_back(i);
+		} else {
+			printer().debug(
+						"character %d shares the bitmap of %d",
+						character_list().at(i).id,
+						character_list().at(m_bitmap_source_list.at(i)).id
+						);
+			duplicate_count++;
+			bytes_saved += calculate_canvas_size(bitmap.area());
+		}
+	}
+
+	printer().info(
+				"%d duplicate character bitmaps (%d bytes saved)",
+				duplicate_count,
+				bytes_saved
+				);
+
+	return duplicate_count;
+}
+
+u32 BmpFontGenerator::calculate_canvas_size(const Area & area) const {
+	//rows are stored as 32-bit words
+	return (area.width() * bits_per_pixel() + 31) / 32 * 4 * area.height();
+}
+
+int BmpFontGenerator::optimize_canvas_dimensions(sg_font_header_t & header){
+	std::vector<u32> order = get_pack_order(character_list(), m_bitmap_source_list);
+	if( order.size() == 0 ){
+		return 0;
+	}
+
+	//the device holds a whole master canvas in RAM -- without a budget
+	//a page is never larger than the default page
+	const Area default_page(header.canvas_width, header.canvas_height);
+	const u32 page_budget = canvas_budget() ?
+				canvas_budget() :
+				calculate_canvas_size(default_page);
+
+	Area best;
+	u32 best_bytes = 0;
+	u32 best_count = 0;
+	u32 candidate_count = 0;
+
+	//widths stay a multiple of 32 pixels so rows are word aligned for any bpp
+	for(u32 words = header.max_word_width; words <= header.max_word_width*16; words++){
+		for(u32 step = 4; step <= 32; step++){
+			Area candidate(words*32, header.max_height * step / 4);
+			u32 page_bytes = calculate_canvas_size(candidate);
+			if( page_bytes > page_budget ){
+				break;
+			}
+
+			AtlasPacker packer(candidate);
+			bool is_fit = true;
+			for(const auto i: order){
+				Point point;
+				if( packer.insert(bitmap_list().at(i).area(), point) < 0 ){
+					is_fit = false;
+					break;
+				}
+			}
+
+			if( !is_fit ){
+				continue;
+			}
+
+			candidate_count++;
+			u32 bytes = packer.bin_count() * page_bytes;
+			//prefer fewer bytes, then fewer canvases
+			if( (best_bytes == 0) ||
+				 (bytes < best_bytes) ||
+				 ((bytes == best_bytes) && (packer.bin_count() < best_count)) ){
+				best = candidate;
+				best_bytes = bytes;
+				best_count = packer.bin_count();
+			}
+		}
+	}
+
+	if( best_bytes == 0 ){
+		printer().warning(
+					"no canvas fits the budget of %d bytes -- using %dx%d",
+					page_budget,
+					header.canvas_width,
+					header.canvas_height
+					);
+		return -1;
+	}
+
+	printer().info(
+				"canvas %dx%d selected from %d candidates (%d canvases, %d bytes) default page %dx%d (%d bytes)",
+				best.width(),
+				best.height(),
+				candidate_count,
+				best_count,
+				best_bytes,
+				default_page.width(),
+				default_page.height(),
+				calculate_canvas_size(default_page)
+				);
+
+	header.canvas_width = best.width();
+	header.canvas_height = best.height();
+	return 0;
+}
+
+int BmpFontGenerator::pack_scan(
+		var::Vector<Bitmap> & master_canvas_list,
+		const Bitmap & master_canvas
+		){
+
+	for(u32 i = 0; i < character_list().count(); i++){
+		//find a place for the character on the master bitmap
+		Region region;
+		Area character_dim(character_list().at(i).width, character_list().at(i).height);
+
+		if( character_dim.width() &&
+			 character_dim.height() &&
+			 (m_bitmap_source_list.at(i) == i) ){
+			do {
+
+				for(u32 j = 0; j < master_canvas_list.count(); j++){
+					region = find_space_on_canvas(master_canvas_list.at(j), bitmap_list().at(i).area());
+					if( region.is_valid() ){
+						printer().debug("allocate %d (%c) to master canvas %d at %d,%d",
+											 character_list().at(i).id,
+											 character_list().at(i).id,
+											 j,
+											 region.x(), region.y());
+						character_list().at(i).canvas_x = region.x();
+						character_list().at(i).canvas_y = region.y();
+						character_list().at(i).canvas_idx = j;
+						break;
+					}
+				}
+
+				if( region.is_valid() == false ){
+					master_canvas_list.push_back(master_canvas);
+				}
+
+			} while( !region.is_valid() );
+		}
+	}
+
+	return 0;
+}
+
+int BmpFontGenerator::pack_skyline(
+		var::Vector<Bitmap> & master_canvas_list,
+		const Bitmap & master_canvas
+		){
+
+	for(u32 i = 0; i < character_list().count(); i++){
+		character_list().at(i).canvas_x = 0;
+		character_list().at(i).canvas_y = 0;
+		character_list().at(i).canvas_idx = 0;
+	}
+
+	std::vector<u32> order = get_pack_order(character_list(), m_bitmap_source_list);
+	AtlasPacker packer(master_canvas.area());
+	for(const auto i: order){
+		Point point;
+		int bin = packer.insert(bitmap_list().at(i).area(), point);
+		if( bin < 0 ){
+			printer().error(
+						"character %d (%dx%d) does not fit on a master canvas",
+						character_list().at(i).id,
+						character_list().at(i).width,
+						character_list().at(i).height
+						);
+			return -1;
+		}
+
+		while( master_canvas_list.count() < (u32)bin + 1 ){
+			master_canvas_list.push_back(master_canvas);
+		}
+
+		printer().debug("allocate %d (%c) to master canvas %d at %d,%d",
+							 character_list().at(i).id,
+							 character_list().at(i).id,
+							 bin,
+							 point.x(), point.y());
+		character_list().at(i).canvas_x = point.x();
+		character_list().at(i).canvas_y = point.y();
+		character_list().at(i).canvas_idx = bin;
+	}
+
+	return 0;
+}
+
 Region BmpFontGenerator::find_space_on_canvas(Bitmap & canvas, Area dimensions){
 	Region region;
 	sg_point_t point;
@@ -30,12 +30,18 @@ private:
 	int generate_map_file(const sg_font_header_t & header, const var::Vector<Bitmap> & master_canvas_list);
 
 	Region find_space_on_canvas(Bitmap & canvas, Area dimensions);
+	u32 find_duplicate_bitmaps();
+	int optimize_canvas_dimensions(sg_font_header_t & header);
+	u32 calculate_canvas_size(const Area & area) const;
+	int pack_scan(var::Vector<Bitmap> & master_canvas_list, const Bitmap & master_canvas);
+	int pack_skyline(var::Vector<Bitmap> & master_canvas_list, const Bitmap & master_canvas);
 	var::String m_map_output_file;
 	bool m_is_ascii;
 	var::Vector<Bitmap> build_master_canvas(const sg_font_header_t & header);
 	var::Vector<sg_font_char_t> m_character_list;
 	var::Vector<sg_font_kerning_pair_t> m_kerning_pair_list;
 	var::Vector<Bitmap> m_bitmap_list;
+	var::Vector<u32> m_bitmap_source_list; //index of the first identical bitmap
 };
 
 #endif // BMPFONTGENERATOR_HPP
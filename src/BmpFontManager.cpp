@@ -63,6 +63,8 @@ int BmpFontManager::generate_map(const String & path){
 	map_path = FileInfo::no_suffix(path) + map_suffix();
 	populate_lists_from_font(path);
 	m_generator.set_bits_per_pixel(bits_per_pixel());
+	m_generator.set_packer(packer());
+	m_generator.set_canvas_budget(canvas_budget());
 	m_generator.set_generate_map();
 	m_generator.set_map_output_file(map_path);
 	m_generator.generate_font_file(String());
@@ -91,7 +93,17 @@ int BmpFontManager::convert_font(const String & path){
 		return -1;
 	}
 
-	Bmp bmp_file(bmp_path);
+	InputFile bmp_input;
+	bmp_image_t bmp_file;
+	if( bmp_input.open(bmp_path) < 0 ){
+		printer().error("failed to open bitmap file %s", bmp_path.cstring());
+		return -1;
+	}
+
+	if( load_bmp_image(bmp_input, bmp_file) < 0 ){
+		printer().error("failed to decode bitmap file %s", bmp_path.cstring());
+		return -1;
+	}
 
 	printer().info("import character definitions and bitmaps");
 	populate_lists_from_bitmap_definition(definition_file, bmp_file);
@@ -99,6 +111,8 @@ int BmpFontManager::convert_font(const String & path){
 	populate_kerning_pair_list_from_bitmap_definition(definition_file);
 	printer().info("generate font file");
 	m_generator.set_bits_per_pixel(bits_per_pixel());
+	m_generator.set_packer(packer());
+	m_generator.set_canvas_budget(canvas_budget());
 	if( is_generate_map() ){
 		m_generator.set_generate_map();
 		m_generator.set_map_output_file(map_path);
@@ -130,7 +144,7 @@ int BmpFontManager::populate_lists_from_font(const var::String & font_path){
 	return 0;
 }
 
-int BmpFontManager::populate_lists_from_bitmap_definition(const File & def, const Bmp & bitmap_file){
+int BmpFontManager::populate_lists_from_bitmap_definition(const File & def, const bmp_image_t & bitmap_file){
 	bmpfont_char_t bmp_definition;
 
 	create_color_index(bitmap_file);
@@ -192,7 +206,7 @@ int BmpFontManager::populate_lists_from_bitmap_definition(const File & def, cons
 	return 0;
 }
 
-int BmpFontManager::add_character_to_lists(const bmpfont_char_t & d, const Bmp & bitmap_file){
+int BmpFontManager::add_character_to_lists(const bmpfont_char_t & d, const bmp_image_t & bitmap_file){
 	sg_font_char_t sg_font_character;
 	sg_font_character.advance_x = d.xadvance;
 	sg_font_character.id = d.id;
@@ -239,14 +253,59 @@ int BmpFontManager::populate_kerning_pair_list_from_bitmap_definition(const File
 	return 0;
 }
 
-int BmpFontManager::create_color_index(const Bmp & bitmap_file){
+int BmpFontManager::load_bmp_image(const InputFile & input, bmp_image_t & image){
+	const u8 * data = input.data();
+	u32 pixel_offset;
+	s32 width;
+	s32 height;
+	u16 bits_per_pixel;
+
+	//14 byte file header followed by the BITMAPINFOHEADER
+	if( (input.size() < 30) || (data[0] != 'B') || (data[1] != 'M') ){
+		return -1;
+	}
+
+	input.read(10, pixel_offset);
+	input.read(18, width);
+	input.read(22, height);
+	input.read(28, bits_per_pixel);
+
+	if( (bits_per_pixel != 24) && (bits_per_pixel != 32) ){
+		printer().error("only 24-bit and 32-bit bitmaps are supported");
+		return -1;
+	}
+
+	if( (width <= 0) || (width > BMP_DIMENSION_MAX) ||
+		 (height == 0) || (height > BMP_DIMENSION_MAX) || (height < -BMP_DIMENSION_MAX) ){
+		printer().error("bitmap dimensions %ldx%ld are not supported", width, height);
+		return -1;
+	}
+
+	image.pixels = 0;
+	image.width = width;
+	image.is_bottom_up = height > 0;
+	image.height = height > 0 ? height : -height;
+	image.bytes_per_pixel = bits_per_pixel / 8;
+	//rows are padded to 4 bytes
+	image.row_size = (image.width * bits_per_pixel + 31) / 32 * 4;
+
+	//the header values are not trusted -- check in 64 bits so nothing wraps
+	if( (pixel_offset > input.size()) ||
+		 ((u64)image.row_size * image.height > (u64)(input.size() - pixel_offset)) ){
+		printer().error("bitmap file is truncated");
+		return -1;
+	}
+
+	image.pixels = data + pixel_offset;
+	return 0;
+}
+
+int BmpFontManager::create_color_index(const bmp_image_t & bitmap_file){
 	u32 i,j,k;
-	u8 pixel[3];
 
-	for(j=0; j < bitmap_file.height(); j++){
-		bitmap_file.seek_row(j);
-		for(i=0; i < bitmap_file.width(); i++){
-			bitmap_file.read(pixel);
+	for(j=0; j < bitmap_file.height; j++){
+		const u8 * pixel = bmp_pixel(bitmap_file, 0, j);
+		for(i=0; i < bitmap_file.width; i++, pixel += bitmap_file.bytes_per_pixel){
 			u32 color = (pixel[0] + pixel[1] + pixel[2]) / 3;
 
 			//see if the color exists in the index
@@ -270,16 +329,13 @@ int BmpFontManager::create_color_index(const Bmp & bitmap_file){
 
 
 
-Bitmap BmpFontManager::get_bitmap(const Bmp & bmp, bmpfont_char_t c){
+Bitmap BmpFontManager::get_bitmap(const bmp_image_t & bmp, bmpfont_char_t c){
 	unsigned int i, j;
 	int x = c.x;
 	int y = c.y;
-	int bytes = bmp.bits_per_pixel()/8;
-	int offset = x*bytes;
 	unsigned int width = c.width;
 	unsigned int height = c.height;
 	int avg;
-	u8 pixel[3];
 	u32 num_colors = 1<< bits_per_pixel();
 	u32 idx;
 
@@ -289,12 +345,15 @@ Bitmap BmpFontManager::get_bitmap(const Bmp & bmp, bmpfont_char_t c){
 				);
 	result.clear();
 
+	if( (x + width > bmp.width) || (y + height > bmp.height) ){
+		printer().error("character %d is outside of the bitmap", c.id);
+		return result;
+	}
+
 	for(j=0; j < height; j++){
-		bmp.seek_row(y + j);
-		bmp.seek(offset, Bmp::CURRENT);
+		const u8 * pixel = bmp_pixel(bmp, x, y + j);
 
-		for(i=0; i < width; i++){
-			bmp.read(pixel);
+		for(i=0; i < width; i++, pixel += bmp.bytes_per_pixel){
 			avg = (pixel[0] + pixel[1] + pixel[2]) / 3;
 
 			//where is brightness in index
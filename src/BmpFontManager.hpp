@@ -6,6 +6,7 @@
 
 #include "FontObject.hpp"
 #include "BmpFontGenerator.hpp"
+#include "InputFile.hpp"
 
 class BmpFontManager : public FontObject {
 public:
@@ -18,6 +19,10 @@ public:
 
 private:
 
+	enum {
+		BMP_DIMENSION_MAX = 32767 //largest width or height of a bitmap image
+	};
+
 	typedef struct {
 		u16 num_chars;
 		u16 num_kernings;
@@ -43,20 +48,34 @@ private:
 		s16 amount;
 	} bmpfont_kerning_t;
 
+	typedef struct {
+		const u8 * pixels;
+		u32 width;
+		u32 height;
+		u32 row_size;
+		u8 bytes_per_pixel;
+		bool is_bottom_up;
+	} bmp_image_t;
+
 
 	int load_bmp_characters(const File & def);
 	int populate_lists_from_font(const String & font_path);
 
-	int populate_lists_from_bitmap_definition(const File & def, const Bmp & bitmap_file);
+	int populate_lists_from_bitmap_definition(const File & def, const bmp_image_t & bitmap_file);
 	int populate_kerning_pair_list_from_bitmap_definition(const File & def);
 
-	int create_color_index(const Bmp & bitmap_file);
+	int create_color_index(const bmp_image_t & bitmap_file);
+	int load_bmp_image(const InputFile & input, bmp_image_t & image);
+	static const u8 * bmp_pixel(const bmp_image_t & image, u32 x, u32 y){
+		u32 row = image.is_bottom_up ? image.height - 1 - y : y;
+		return image.pixels + row * image.row_size + x * image.bytes_per_pixel;
+	}
 
 	int load_char(bmpfont_char_t & c, const Tokenizer & t);
 	int get_char(const File & def, bmpfont_char_t & d, uint8_t ascii);
-	Bitmap get_bitmap(const Bmp & bmp, bmpfont_char_t c);
+	Bitmap get_bitmap(const bmp_image_t & bmp, bmpfont_char_t c);
 
-	int add_character_to_lists(const bmpfont_char_t & d, const Bmp & bitmap_file);
+	int add_character_to_lists(const bmpfont_char_t & d, const bmp_image_t & bitmap_file);
 
 	var::Vector<u32> m_bmp_color_index;
 
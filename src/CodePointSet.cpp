@@ -0,0 +1,41 @@
+/*! \file */ //Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+#include "CodePointSet.hpp"
+
+CodePointSet::CodePointSet(){
+	m_count = 0;
+}
+
+void CodePointSet::clear(){
+	m_bits = var::Vector<u32>();
+	m_count = 0;
+}
+
+bool CodePointSet::insert(u32 code_point){
+	if( code_point >= CODE_POINT_LIMIT ){
+		return false;
+	}
+
+	if( m_bits.count() == 0 ){
+		m_bits.resize(CODE_POINT_LIMIT / 32);
+		for(auto & word: m_bits){
+			word = 0;
+		}
+	}
+
+	u32 & word = m_bits.at(code_point / 32);
+	u32 mask = 1U << (code_point % 32);
+	if( word & mask ){
+		return false;
+	}
+
+	word |= mask;
+	m_count++;
+	return true;
+}
+
+void CodePointSet::insert(const var::String & characters){
+	for(const auto c: characters){
+		insert((u8)c);
+	}
+}
@@ -0,0 +1,47 @@
+/*! \file */ //Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+
+#ifndef CODEPOINTSET_HPP_
+#define CODEPOINTSET_HPP_
+
+#include <sapi/var.hpp>
+
+/*! \details Set of character code points with constant time lookup.
+ *
+ * The set is a flat bitset over the 16-bit range used by
+ * sg_font_char_t::id. Memory (8KB) is only allocated when the first
+ * code point is inserted. Code points outside of the range are
+ * never members.
+ *
+ */
+class CodePointSet {
+public:
+	CodePointSet();
+
+	void clear();
+
+	/*! \details Inserts a code point and returns true if it was not already present. */
+	bool insert(u32 code_point);
+
+	/*! \details Inserts each character of \a characters. */
+	void insert(const var::String & characters);
+
+	bool contains(u32 code_point) const {
+		if( (code_point >= CODE_POINT_LIMIT) || (m_bits.count() == 0) ){
+			return false;
+		}
+		return (m_bits.at(code_point / 32) & (1U << (code_point % 32))) != 0;
+	}
+
+	u32 count() const { return m_count; }
+
+private:
+	enum {
+		CODE_POINT_LIMIT = 0x10000
+	};
+
+	var::Vector<u32> m_bits;
+	u32 m_count;
+};
+
+#endif /* CODEPOINTSET_HPP_ */
@@ -0,0 +1,95 @@
+/*! \file */ //Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+#include <cmath>
+#include "CoordinateBatch.hpp"
+
+CoordinateBatch::CoordinateBatch(){
+	set_transform(1.0f, 1);
+	m_x_min = 0.0f;
+	m_x_max = 0.0f;
+	m_y_min = 0.0f;
+	m_y_max = 0.0f;
+}
+
+void CoordinateBatch::set_transform(float scale, int sign_y){
+	m_scale = scale;
+	m_sign_y = sign_y;
+	m_shift_x = SG_MAP_MAX/2.0f;
+	m_shift_y = sign_y * SG_MAP_MAX/2.0f;
+}
+
+void CoordinateBatch::clear(){
+	m_commands.clear();
+	m_x.clear();
+	m_y.clear();
+	m_offset_x.clear();
+	m_offset_y.clear();
+}
+
+u32 CoordinateBatch::transform(){
+	const u32 total = m_x.size();
+	m_scaled_x.resize(total);
+	m_scaled_y.resize(total);
+	m_mapped_x.resize(total);
+	m_mapped_y.resize(total);
+
+	if( total == 0 ){
+		m_x_min = m_x_max = m_y_min = m_y_max = 0.0f;
+		return 0;
+	}
+
+	//no branches in the loops so they can be vectorized -- scaling and
+	//shifting are separate (not fused) so the results are the same as
+	//mapping one point at a time
+	const float * x = m_x.data();
+	const float * y = m_y.data();
+	const float * offset_x = m_offset_x.data();
+	const float * offset_y = m_offset_y.data();
+	float * scaled_x = m_scaled_x.data();
+	float * scaled_y = m_scaled_y.data();
+	for(u32 i=0; i < total; i++){
+		scaled_x[i] = x[i] * m_scale;
+		scaled_y[i] = y[i] * m_scale * m_sign_y;
+	}
+
+	for(u32 i=0; i < total; i++){
+		scaled_x[i] -= offset_x[i];
+		scaled_y[i] -= offset_y[i];
+	}
+
+	float x_min = scaled_x[0];
+	float x_max = scaled_x[0];
+	float y_min = scaled_y[0];
+	float y_max = scaled_y[0];
+	for(u32 i=1; i < total; i++){
+		x_min = scaled_x[i] < x_min ? scaled_x[i] : x_min;
+		x_max = scaled_x[i] > x_max ? scaled_x[i] : x_max;
+		y_min = scaled_y[i] < y_min ? scaled_y[i] : y_min;
+		y_max = scaled_y[i] > y_max ? scaled_y[i] : y_max;
+	}
+	m_x_min = x_min;
+	m_x_max = x_max;
+	m_y_min = y_min;
+	m_y_max = y_max;
+
+	u32 out_of_range = 0;
+	if( (x_min < -1*SG_MAX) || (x_max > SG_MAX) ||
+		 (y_min < -1*SG_MAX) || (y_max > SG_MAX) ){
+		for(u32 i=0; i < total; i++){
+			if( (scaled_x[i] < -1*SG_MAX) || (scaled_x[i] > SG_MAX) ||
+				 (scaled_y[i] < -1*SG_MAX) || (scaled_y[i] > SG_MAX) ){
+				out_of_range++;
+			}
+		}
+		return out_of_range;
+	}
+
+	sg_int_t * mapped_x = m_mapped_x.data();
+	sg_int_t * mapped_y = m_mapped_y.data();
+	for(u32 i=0; i < total; i++){
+		mapped_x[i] = rintf(scaled_x[i]);
+		mapped_y[i] = rintf(scaled_y[i]);
+	}
+
+	return 0;
+}
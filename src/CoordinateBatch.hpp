@@ -0,0 +1,105 @@
+/*! \file */ //Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+
+#ifndef COORDINATEBATCH_HPP_
+#define COORDINATEBATCH_HPP_
+
+#include <vector>
+#include <sapi/var.hpp>
+#include <sapi/sgfx.hpp>
+
+/*! \details Maps the coordinates of a whole path to vector space at once.
+ *
+ * The parser adds each command and its raw coordinates (in SVG
+ * units) as they are read. transform() then scales, shifts and
+ * rounds every coordinate in one pass over contiguous arrays with a
+ * scale and shift calculated once, and checks the range of the path
+ * as a whole. The elements are built from the mapped points after
+ * the transform.
+ *
+ * The arithmetic is the same as mapping one point at a time: x is
+ * scaled, y is scaled and flipped with the sign, and absolute
+ * coordinates are shifted by half of SG_MAP_MAX so the center of
+ * the map is the origin.
+ *
+ * ```
+ * CoordinateBatch batch;
+ * batch.set_transform(scale, -1);
+ * batch.add_command('M');
+ * batch.add(10.0f, 20.0f, true);
+ * if( batch.transform() == 0 ){
+ *   Point p = batch.at(0);
+ * }
+ * ```
+ *
+ */
+class CoordinateBatch {
+public:
+	CoordinateBatch();
+
+	/*! \details Sets the scale from SVG units to vector space and the
+	 * direction of the y axis (-1 to flip) for the coordinates added next.
+	 */
+	void set_transform(float scale, int sign_y);
+
+	/*! \details Removes the commands and coordinates keeping the memory. */
+	void clear();
+
+	void add_command(char command){
+		m_commands.push_back(command);
+	}
+
+	/*! \details Adds a coordinate. Relative coordinates are scaled but not shifted. */
+	void add(float x, float y, bool is_absolute){
+		m_x.push_back(x);
+		m_y.push_back(y);
+		m_offset_x.push_back(is_absolute ? m_shift_x : 0.0f);
+		m_offset_y.push_back(is_absolute ? m_shift_y : 0.0f);
+	}
+
+	/*! \details Maps every coordinate to vector space.
+	 *
+	 * Returns the number of coordinates outside of -SG_MAX to SG_MAX
+	 * (zero when the whole path can be mapped). Points outside of the
+	 * range are not clipped.
+	 *
+	 */
+	u32 transform();
+
+	u32 command_count() const { return m_commands.size(); }
+	char command(u32 i) const { return m_commands.at(i); }
+
+	u32 count() const { return m_x.size(); }
+
+	/*! \details Returns the mapped point \a i (after transform()). */
+	sgfx::Point at(u32 i) const {
+		return sgfx::Point(m_mapped_x.at(i), m_mapped_y.at(i));
+	}
+
+	/*! \details Bounds of the scaled coordinates from the last transform(). */
+	float x_min() const { return m_x_min; }
+	float x_max() const { return m_x_max; }
+	float y_min() const { return m_y_min; }
+	float y_max() const { return m_y_max; }
+
+private:
+	float m_scale;
+	float m_sign_y;
+	float m_shift_x;
+	float m_shift_y;
+	float m_x_min;
+	float m_x_max;
+	float m_y_min;
+	float m_y_max;
+	std::vector<char> m_commands;
+	std::vector<float> m_x;
+	std::vector<float> m_y;
+	std::vector<float> m_offset_x; //shift of each coordinate (zero if relative)
+	std::vector<float> m_offset_y;
+	std::vector<float> m_scaled_x;
+	std::vector<float> m_scaled_y;
+	std::vector<sg_int_t> m_mapped_x;
+	std::vector<sg_int_t> m_mapped_y;
+};
+
+#endif /* COORDINATEBATCH_HPP_ */
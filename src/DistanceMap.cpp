@@ -0,0 +1,111 @@
+/*! \file */ //Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+#include "DistanceMap.hpp"
+#include "RunTable.hpp"
+
+DistanceMap::DistanceMap(){
+	m_left = 0;
+	m_top = 0;
+	m_width = 0;
+	m_height = 0;
+	m_maximum = 0;
+}
+
+DistanceMap::DistanceMap(const sgfx::Bitmap & bitmap){
+	calculate(bitmap);
+}
+
+void DistanceMap::calculate(const sgfx::Bitmap & bitmap){
+	RunTable run_table(bitmap);
+	calculate(run_table, sgfx::Region(sgfx::Point(0,0), run_table.area()));
+}
+
+void DistanceMap::calculate(const RunTable & run_table, const sgfx::Region & window){
+	m_left = window.point().x();
+	m_top = window.point().y();
+	m_width = window.area().width();
+	m_height = window.area().height();
+	m_maximum = 0;
+	m_distances.resize(m_width * m_height);
+
+	//background starts far away and set pixels are zero
+	const u16 far = 0xffff - DIAGONAL;
+	const sg_int_t right = m_left + m_width;
+	for(u32 y = 0; y < m_height; y++){
+		u16 * line = &m_distances.at(y * m_width);
+		for(u32 x = 0; x < m_width; x++){
+			line[x] = far;
+		}
+
+		for(const RowScanner::run_t * run = run_table.begin(m_top + y);
+			 run < run_table.end(m_top + y);
+			 run++){
+			sg_int_t start = run->start < m_left ? m_left : run->start;
+			sg_int_t end = run->end > right ? right : run->end;
+			for(sg_int_t x = start; x < end; x++){
+				line[x - m_left] = 0;
+			}
+		}
+	}
+
+	//the edge of the window is one step away from outside
+	auto relax = [&](u16 & value, u32 x, u32 y, int dx, int dy, u16 step){
+		const int nx = (int)x + dx;
+		const int ny = (int)y + dy;
+		u16 neighbor = 0;
+		if( (nx >= 0) && (ny >= 0) && ((u32)nx < m_width) && ((u32)ny < m_height) ){
+			neighbor = m_distances.at(ny * m_width + nx);
+		}
+		if( neighbor + step < value ){
+			value = neighbor + step;
+		}
+	};
+
+	for(u32 y = 0; y < m_height; y++){
+		for(u32 x = 0; x < m_width; x++){
+			u16 & value = m_distances.at(y * m_width + x);
+			if( value == 0 ){
+				continue;
+			}
+			relax(value, x, y, -1, 0, ORTHOGONAL);
+			relax(value, x, y, -1, -1, DIAGONAL);
+			relax(value, x, y, 0, -1, ORTHOGONAL);
+			relax(value, x, y, 1, -1, DIAGONAL);
+		}
+	}
+
+	for(u32 y = m_height; y > 0; y--){
+		for(u32 x = m_width; x > 0; x--){
+			u16 & value = m_distances.at((y-1) * m_width + x-1);
+			if( value == 0 ){
+				continue;
+			}
+			relax(value, x-1, y-1, 1, 0, ORTHOGONAL);
+			relax(value, x-1, y-1, 1, 1, DIAGONAL);
+			relax(value, x-1, y-1, 0, 1, ORTHOGONAL);
+			relax(value, x-1, y-1, -1, 1, DIAGONAL);
+			if( value > m_maximum ){
+				m_maximum = value;
+			}
+		}
+	}
+}
+
+void DistanceMap::draw(sgfx::Bitmap & bitmap) const {
+	const u32 color_max = (1 << bitmap.bits_per_pixel()) - 1;
+	bitmap.clear();
+	if( m_maximum == 0 ){
+		return;
+	}
+
+	for(u32 y = 0; (y < m_height) && (y < (u32)bitmap.height()); y++){
+		for(u32 x = 0; (x < m_width) && (x < (u32)bitmap.width()); x++){
+			u16 value = m_distances.at(y * m_width + x);
+			if( value ){
+				sg_color_t color = (value * color_max + m_maximum - 1) / m_maximum;
+				bitmap.set_pen( sgfx::Pen().set_color(color) );
+				bitmap.draw_pixel(sgfx::Point(x,y));
+			}
+		}
+	}
+}
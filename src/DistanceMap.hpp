@@ -0,0 +1,84 @@
+/*! \file */ //Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+
+#ifndef DISTANCEMAP_HPP_
+#define DISTANCEMAP_HPP_
+
+#include <sapi/var.hpp>
+#include <sapi/sgfx.hpp>
+
+class RunTable;
+
+/*! \details Distance from each background pixel to the nearest set pixel.
+ *
+ * The distances are a 3-4 chamfer transform computed in two passes
+ * (top-left to bottom-right and back). A step to a side neighbor
+ * costs ORTHOGONAL and a step to a corner neighbor costs DIAGONAL,
+ * so the value divided by ORTHOGONAL is within 8% of the Euclidean
+ * distance. Set pixels are zero and the area outside of the bitmap
+ * counts as set.
+ *
+ * The pixel with the largest distance in a region is the one
+ * furthest from every edge -- the most central place to pour.
+ *
+ */
+class DistanceMap {
+public:
+	DistanceMap();
+	DistanceMap(const sgfx::Bitmap & bitmap);
+
+	/*! \details Replaces the distances with those of \a bitmap. */
+	void calculate(const sgfx::Bitmap & bitmap);
+
+	/*! \details Calculates the distances of \a run_table inside \a window only.
+	 *
+	 * The area outside of \a window counts as set. For a window that
+	 * covers a background region plus one pixel on each side, the
+	 * distances in that region are the same as for the whole bitmap:
+	 * the region is bounded by set pixels inside the window, so the
+	 * nearest set pixel is never outside of it.
+	 *
+	 */
+	void calculate(const RunTable & run_table, const sgfx::Region & window);
+
+	enum {
+		ORTHOGONAL = 3,
+		DIAGONAL = 4
+	};
+
+	/*! \details Returns the chamfer distance at \a point (zero if set or outside the window). */
+	u16 at(const sgfx::Point & point) const {
+		const int x = point.x() - m_left;
+		const int y = point.y() - m_top;
+		if( (x < 0) || (y < 0) ||
+			 ((u32)x >= m_width) || ((u32)y >= m_height) ){
+			return 0;
+		}
+		return m_distances.at(y * m_width + x);
+	}
+
+	/*! \details Returns the distance at \a point in pixels. */
+	float distance(const sgfx::Point & point) const {
+		return at(point) * 1.0f / ORTHOGONAL;
+	}
+
+	u16 maximum() const { return m_maximum; }
+
+	/*! \details Draws the distances on \a bitmap for debugging.
+	 *
+	 * The largest distance is drawn with the highest color the bitmap's
+	 * bits per pixel allow and set pixels are left clear.
+	 *
+	 */
+	void draw(sgfx::Bitmap & bitmap) const;
+
+private:
+	sg_int_t m_left;
+	sg_int_t m_top;
+	u32 m_width;
+	u32 m_height;
+	u16 m_maximum;
+	var::Vector<u16> m_distances;
+};
+
+#endif /* DISTANCEMAP_HPP_ */
@@ -5,4 +5,6 @@ FontObject::FontObject(){
 	m_is_generate_map = false;
 	m_character_set = Font::ascii_character_set();
 	m_is_ascii = true;
+	m_packer = PACKER_SKYLINE;
+	m_canvas_budget = 0;
 }
@@ -13,6 +13,11 @@ class FontObject : public ApplicationPrinter {
 public:
 	FontObject();
 
+	enum packer {
+		PACKER_SKYLINE /*! Skyline rectangle packer (default) */,
+		PACKER_SCAN /*! Scans every canvas position for empty space */
+	};
+
 	void set_generate_map(bool value = true){
 		m_is_generate_map = value;
 	}
@@ -35,6 +40,26 @@ public:
 
 	u8 bits_per_pixel() const { return m_bits_per_pixel; }
 
+	void set_packer(enum packer value){
+		m_packer = value;
+	}
+
+	enum packer packer() const { return m_packer; }
+
+	/*! \details Sets the maximum size in bytes of a master canvas.
+	 *
+	 * With the skyline packer the canvas dimensions are chosen to
+	 * minimize the total size of the master canvases. A budget limits
+	 * the size of each canvas (more, smaller canvases). Zero means no
+	 * limit.
+	 *
+	 */
+	void set_canvas_budget(u32 bytes){
+		m_canvas_budget = bytes;
+	}
+
+	u32 canvas_budget() const { return m_canvas_budget; }
+
 	const String & character_set() const { return m_character_set; }
 
 protected:
@@ -46,6 +71,8 @@ private:
 	u8 m_bits_per_pixel;
 	bool m_is_generate_map;
 	bool m_is_ascii;
+	enum packer m_packer;
+	u32 m_canvas_budget;
 
 	String m_character_set;
 
@@ -0,0 +1,118 @@
+/*! \file */ //Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "InputFile.hpp"
+
+#if defined __link && (defined __linux__ || defined __APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#define HAS_MMAP 1
+#endif
+
+InputFile::InputFile(){
+	m_data = 0;
+	m_size = 0;
+	m_is_mapped = false;
+}
+
+InputFile::~InputFile(){
+	close();
+}
+
+int InputFile::open(const var::String & path){
+	if( map(path) == 0 ){
+		return 0;
+	}
+	return load(path);
+}
+
+int InputFile::map(const var::String & path){
+	close();
+#if defined HAS_MMAP
+	int fd = ::open(path.cstring(), O_RDONLY);
+	if( fd < 0 ){
+		return -1;
+	}
+
+	struct stat st;
+	if( (fstat(fd, &st) < 0) || (st.st_size == 0) ){
+		//empty files can't be mapped -- let the caller load them
+		::close(fd);
+		return -1;
+	}
+
+	void * data = mmap(0, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	//the mapping stays valid after the descriptor is closed
+	::close(fd);
+	if( data == MAP_FAILED ){
+		return -1;
+	}
+
+	madvise(data, st.st_size, MADV_SEQUENTIAL);
+	m_data = (u8*)data;
+	m_size = st.st_size;
+	m_is_mapped = true;
+	return 0;
+#else
+	return -1;
+#endif
+}
+
+int InputFile::load(const var::String & path){
+	FILE * file = fopen(path.cstring(), "rb");
+	if( file == 0 ){
+		printer().error("failed to open %s", path.cstring());
+		return -1;
+	}
+
+	u32 capacity = 0;
+	size_t bytes_read;
+	do {
+		if( m_size == capacity ){
+			capacity = capacity ? capacity*2 : 4096;
+			u8 * data = (u8*)realloc(m_data, capacity);
+			if( data == 0 ){
+				printer().error("failed to allocate memory for %s", path.cstring());
+				fclose(file);
+				close();
+				return -1;
+			}
+			m_data = data;
+		}
+		bytes_read = fread(m_data + m_size, 1, capacity - m_size, file);
+		m_size += bytes_read;
+	} while( bytes_read > 0 );
+
+	fclose(file);
+	return 0;
+}
+
+void InputFile::close(){
+#if defined HAS_MMAP
+	if( m_is_mapped ){
+		munmap(m_data, m_size);
+		m_data = 0;
+	}
+#endif
+	free(m_data);
+	m_data = 0;
+	m_size = 0;
+	m_is_mapped = false;
+}
+
+int InputFile::read(u32 offset, void * destination, u32 size) const {
+	if( offset >= m_size ){
+		return 0;
+	}
+
+	if( size > m_size - offset ){
+		size = m_size - offset;
+	}
+
+	memcpy(destination, m_data + offset, size);
+	return size;
+}
@@ -0,0 +1,70 @@
+/*! \file */ //Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+
+#ifndef INPUTFILE_HPP_
+#define INPUTFILE_HPP_
+
+#include <sapi/var.hpp>
+#include "ApplicationPrinter.hpp"
+
+/*! \details Read-only view of an input file as one contiguous block.
+ *
+ * On the desktop (link) build the file is memory mapped so parsers
+ * can walk a `const u8 *` without a system call per record. When
+ * mapping is not available (embedded builds) open() falls back to
+ * reading the file into a heap buffer using buffered reads.
+ *
+ * ```
+ * InputFile input;
+ * if( input.open(path) == 0 ){
+ *   sg_font_header_t header;
+ *   input.read(0, header);
+ * }
+ * ```
+ *
+ */
+class InputFile : public ApplicationPrinter {
+public:
+	InputFile();
+	~InputFile();
+
+	/*! \details Maps the file or reads it into memory. */
+	int open(const var::String & path);
+
+	/*! \details Maps the file without the buffered fallback.
+	 *
+	 * Returns -1 if the file cannot be mapped. Streaming readers use
+	 * this so they can keep a small window when mapping is not
+	 * available.
+	 *
+	 */
+	int map(const var::String & path);
+
+	void close();
+
+	const u8 * data() const { return m_data; }
+	const char * text() const { return (const char*)m_data; }
+	u32 size() const { return m_size; }
+	bool is_mapped() const { return m_is_mapped; }
+
+	/*! \details Copies \a size bytes from \a offset.
+	 *
+	 * Returns the number of bytes copied which is less than
+	 * \a size if the read goes past the end of the file.
+	 *
+	 */
+	int read(u32 offset, void * destination, u32 size) const;
+
+	template<typename T> int read(u32 offset, T & value) const {
+		return read(offset, &value, sizeof(T));
+	}
+
+private:
+	u8 * m_data;
+	u32 m_size;
+	bool m_is_mapped;
+
+	int load(const var::String & path);
+};
+
+#endif /* INPUTFILE_HPP_ */
@@ -0,0 +1,446 @@
+/*! \file */ //Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+#include <cmath>
+#include "PathGeometry.hpp"
+
+PathGeometry::PathGeometry(){
+	m_tolerance = DEFAULT_TOLERANCE;
+	m_curve_count = 0;
+	m_is_open = false;
+	m_start.x = 0;
+	m_start.y = 0;
+	m_current = m_start;
+}
+
+u32 PathGeometry::flatten(
+		const var::Vector<sg_vector_path_description_t> & elements,
+		const Region & region
+		){
+	m_region = region;
+	m_segments = var::Vector<segment_t>();
+	m_curve_count = 0;
+	m_is_open = false;
+
+	for(const auto & element: elements){
+		switch(element.type){
+			case SG_VECTOR_PATH_MOVE:
+				close_path();
+				m_start = map_point(element.move.point);
+				m_current = m_start;
+				m_is_open = true;
+				break;
+			case SG_VECTOR_PATH_LINE:
+				line_to(map_point(element.line.point));
+				break;
+			case SG_VECTOR_PATH_QUADRATIC_BEZIER:
+				add_quadratic(
+							map_point(element.quadratic_bezier.control),
+							map_point(element.quadratic_bezier.point)
+							);
+				break;
+			case SG_VECTOR_PATH_CUBIC_BEZIER:
+				add_cubic(
+							map_point(element.cubic_bezier.control[0]),
+							map_point(element.cubic_bezier.control[1]),
+							map_point(element.cubic_bezier.point)
+							);
+				break;
+			case SG_VECTOR_PATH_CLOSE:
+				close_path();
+				break;
+			default:
+				//pour points are not part of the outline
+				break;
+		}
+	}
+
+	close_path();
+	return m_segments.count();
+}
+
+var::Vector<sg_vector_path_description_t> PathGeometry::flatten_to_lines(
+		const var::Vector<sg_vector_path_description_t> & elements,
+		const Region & region
+		){
+	var::Vector<sg_vector_path_description_t> result;
+	sg_point_t start = {0, 0};
+	sg_point_t current = start;
+	m_curve_count = 0;
+
+	for(const auto & element: elements){
+		switch(element.type){
+			case SG_VECTOR_PATH_MOVE:
+				start = element.move.point;
+				current = start;
+				result.push_back(element);
+				break;
+			case SG_VECTOR_PATH_LINE:
+				current = element.line.point;
+				result.push_back(element);
+				break;
+			case SG_VECTOR_PATH_CLOSE:
+				current = start;
+				result.push_back(element);
+				break;
+			case SG_VECTOR_PATH_QUADRATIC_BEZIER:
+			case SG_VECTOR_PATH_CUBIC_BEZIER:
+			{
+				//the steps come from the curve in pixels
+				const bool is_cubic = element.type == SG_VECTOR_PATH_CUBIC_BEZIER;
+				const sg_point_t control0 = is_cubic ?
+							element.cubic_bezier.control[0] :
+							element.quadratic_bezier.control;
+				const sg_point_t control1 = is_cubic ?
+							element.cubic_bezier.control[1] :
+							control0;
+				const sg_point_t point = is_cubic ?
+							element.cubic_bezier.point :
+							element.quadratic_bezier.point;
+				const float bend = is_cubic ?
+							calculate_cubic_bend(
+								map_point(current.x, current.y, region),
+								map_point(control0.x, control0.y, region),
+								map_point(control1.x, control1.y, region),
+								map_point(point.x, point.y, region)
+								) :
+							calculate_quadratic_bend(
+								map_point(current.x, current.y, region),
+								map_point(control0.x, control0.y, region),
+								map_point(point.x, point.y, region)
+								);
+				u32 steps = calculate_steps(bend, m_tolerance);
+				m_curve_count++;
+
+				for(u32 i = 1; i < steps; i++){
+					float t = 1.0f * i / steps;
+					float u = 1.0f - t;
+					float x, y;
+					if( is_cubic ){
+						x = u*u*u*current.x + 3*u*u*t*control0.x + 3*u*t*t*control1.x + t*t*t*point.x;
+						y = u*u*u*current.y + 3*u*u*t*control0.y + 3*u*t*t*control1.y + t*t*t*point.y;
+					} else {
+						x = u*u*current.x + 2*u*t*control0.x + t*t*point.x;
+						y = u*u*current.y + 2*u*t*control0.y + t*t*point.y;
+					}
+					result.push_back(sgfx::Vector::get_path_line(sgfx::Point(rintf(x), rintf(y))));
+				}
+				result.push_back(sgfx::Vector::get_path_line(sgfx::Point(point.x, point.y)));
+				current = point;
+				break;
+			}
+			default:
+				result.push_back(element);
+				break;
+		}
+	}
+
+	return result;
+}
+
+Region PathGeometry::calculate_pixel_bounds() const {
+	if( m_segments.count() == 0 ){
+		return Region();
+	}
+
+	//segments are closed so the start points cover every vertex
+	float x_min = m_segments.at(0).x0;
+	float x_max = x_min;
+	float y_min = m_segments.at(0).y0;
+	float y_max = y_min;
+	for(const auto & segment: m_segments){
+		if( segment.x0 < x_min ){ x_min = segment.x0; }
+		if( segment.x0 > x_max ){ x_max = segment.x0; }
+		if( segment.y0 < y_min ){ y_min = segment.y0; }
+		if( segment.y0 > y_max ){ y_max = segment.y0; }
+	}
+
+	return clip_pixels(
+				(int)floorf(x_min),
+				(int)floorf(y_min),
+				(int)ceilf(x_max),
+				(int)ceilf(y_max),
+				m_region
+				);
+}
+
+Region PathGeometry::clip_pixels(
+		int left,
+		int top,
+		int right,
+		int bottom,
+		const Region & region
+		){
+	const int region_left = region.point().x();
+	const int region_top = region.point().y();
+	const int region_right = region_left + region.area().width();
+	const int region_bottom = region_top + region.area().height();
+	if( left < region_left ){ left = region_left; }
+	if( top < region_top ){ top = region_top; }
+	if( right > region_right ){ right = region_right; }
+	if( bottom > region_bottom ){ bottom = region_bottom; }
+
+	if( (right <= left) || (bottom <= top) ){
+		return Region();
+	}
+
+	return Region(Point(left, top), Area(right - left, bottom - top));
+}
+
+bool PathGeometry::calculate_bounds(
+		const var::Vector<sg_vector_path_description_t> & elements,
+		bounds_t & bounds
+		){
+	bool is_empty = true;
+	bool is_move_pending = false;
+	float current[2] = {0.0f, 0.0f};
+	float start[2] = {0.0f, 0.0f};
+
+	for(const auto & element: elements){
+		const sg_point_t * end = 0;
+		switch(element.type){
+			case SG_VECTOR_PATH_MOVE:
+				//a move only counts once something is drawn from it
+				current[0] = start[0] = element.move.point.x;
+				current[1] = start[1] = element.move.point.y;
+				is_move_pending = true;
+				continue;
+			case SG_VECTOR_PATH_LINE:
+				end = &element.line.point;
+				break;
+			case SG_VECTOR_PATH_QUADRATIC_BEZIER:
+				end = &element.quadratic_bezier.point;
+				break;
+			case SG_VECTOR_PATH_CUBIC_BEZIER:
+				end = &element.cubic_bezier.point;
+				break;
+			case SG_VECTOR_PATH_CLOSE:
+				current[0] = start[0];
+				current[1] = start[1];
+				continue;
+			default:
+				continue;
+		}
+
+		if( is_empty ){
+			bounds.x_min = bounds.x_max = end->x;
+			bounds.y_min = bounds.y_max = end->y;
+			is_empty = false;
+		}
+
+		if( is_move_pending ){
+			include_point(bounds, current[0], current[1]);
+			is_move_pending = false;
+		}
+
+		if( element.type == SG_VECTOR_PATH_QUADRATIC_BEZIER ){
+			const sg_point_t & control = element.quadratic_bezier.control;
+			const float x[3] = { current[0], (float)control.x, (float)end->x };
+			const float y[3] = { current[1], (float)control.y, (float)end->y };
+			//derivative is linear: (p1 - p0) + t*(p0 - 2p1 + p2) = 0
+			include_extremum(bounds, 0.0f, x[0] - 2*x[1] + x[2], x[1] - x[0], x, y, 2);
+			include_extremum(bounds, 0.0f, y[0] - 2*y[1] + y[2], y[1] - y[0], x, y, 2);
+		} else if( element.type == SG_VECTOR_PATH_CUBIC_BEZIER ){
+			const sg_point_t * control = element.cubic_bezier.control;
+			const float x[4] = { current[0], (float)control[0].x, (float)control[1].x, (float)end->x };
+			const float y[4] = { current[1], (float)control[0].y, (float)control[1].y, (float)end->y };
+			//derivative / 3 = a*t^2 + b*t + c
+			include_extremum(
+						bounds,
+						x[3] - 3*x[2] + 3*x[1] - x[0],
+						2*(x[2] - 2*x[1] + x[0]),
+						x[1] - x[0],
+						x, y, 3
+						);
+			include_extremum(
+						bounds,
+						y[3] - 3*y[2] + 3*y[1] - y[0],
+						2*(y[2] - 2*y[1] + y[0]),
+						y[1] - y[0],
+						x, y, 3
+						);
+		}
+
+		include_point(bounds, end->x, end->y);
+		current[0] = end->x;
+		current[1] = end->y;
+	}
+
+	return is_empty == false;
+}
+
+Region PathGeometry::map_bounds(const bounds_t & bounds, const Region & region){
+	point_t top_left = map_point(bounds.x_min, bounds.y_min, region);
+	point_t bottom_right = map_point(bounds.x_max, bounds.y_max, region);
+	//a point on x.y lands in pixel floor(x.y)
+	return clip_pixels(
+				(int)floorf(top_left.x),
+				(int)floorf(top_left.y),
+				(int)floorf(bottom_right.x) + 1,
+				(int)floorf(bottom_right.y) + 1,
+				region
+				);
+}
+
+void PathGeometry::include_point(bounds_t & bounds, float x, float y){
+	if( x < bounds.x_min ){ bounds.x_min = x; }
+	if( x > bounds.x_max ){ bounds.x_max = x; }
+	if( y < bounds.y_min ){ bounds.y_min = y; }
+	if( y > bounds.y_max ){ bounds.y_max = y; }
+}
+
+void PathGeometry::include_extremum(
+		bounds_t & bounds,
+		float a,
+		float b,
+		float c,
+		const float * x,
+		const float * y,
+		u32 order
+		){
+	//roots of a*t^2 + b*t + c in (0,1)
+	float roots[2];
+	u32 root_count = 0;
+	if( fabsf(a) < 1e-6f ){
+		if( fabsf(b) > 1e-6f ){
+			roots[root_count++] = -c / b;
+		}
+	} else {
+		float discriminant = b*b - 4*a*c;
+		if( discriminant >= 0.0f ){
+			float root = sqrtf(discriminant);
+			roots[root_count++] = (-b + root) / (2*a);
+			roots[root_count++] = (-b - root) / (2*a);
+		}
+	}
+
+	for(u32 i=0; i < root_count; i++){
+		float t = roots[i];
+		if( (t <= 0.0f) || (t >= 1.0f) ){
+			continue;
+		}
+		float u = 1.0f - t;
+		if( order == 2 ){
+			include_point(
+						bounds,
+						u*u*x[0] + 2*u*t*x[1] + t*t*x[2],
+						u*u*y[0] + 2*u*t*y[1] + t*t*y[2]
+						);
+		} else {
+			include_point(
+						bounds,
+						u*u*u*x[0] + 3*u*u*t*x[1] + 3*u*t*t*x[2] + t*t*t*x[3],
+						u*u*u*y[0] + 3*u*u*t*y[1] + 3*u*t*t*y[2] + t*t*t*y[3]
+						);
+		}
+	}
+}
+
+PathGeometry::point_t PathGeometry::map_point(const sg_point_t & point) const {
+	return map_point(point.x, point.y, m_region);
+}
+
+PathGeometry::point_t PathGeometry::map_point(float x, float y, const Region & region){
+	//same scale as sg_point_map(): -SG_MAX to SG_MAX spans the region
+	point_t result;
+	result.x = (x + SG_MAX) * region.area().width() / (2.0f*SG_MAX) + region.point().x();
+	result.y = (y + SG_MAX) * region.area().height() / (2.0f*SG_MAX) + region.point().y();
+	return result;
+}
+
+void PathGeometry::line_to(const point_t & point){
+	if( (point.x != m_current.x) || (point.y != m_current.y) ){
+		segment_t segment;
+		segment.x0 = m_current.x;
+		segment.y0 = m_current.y;
+		segment.x1 = point.x;
+		segment.y1 = point.y;
+		m_segments.push_back(segment);
+	}
+	m_current = point;
+	m_is_open = true;
+}
+
+void PathGeometry::close_path(){
+	if( m_is_open ){
+		line_to(m_start);
+		m_is_open = false;
+	}
+}
+
+void PathGeometry::set_tolerance(float value){
+	m_tolerance = value < MINIMUM_TOLERANCE ? MINIMUM_TOLERANCE : value;
+}
+
+u32 PathGeometry::calculate_steps(float bend, float tolerance){
+	//n even steps keep a curve within bend / n^2 of its chords
+	u32 steps = (u32)ceilf(sqrtf(bend / tolerance));
+	if( steps < 1 ){ return 1; }
+	return steps > (u32)STEPS_MAX ? (u32)STEPS_MAX : steps;
+}
+
+float PathGeometry::calculate_quadratic_bend(
+		const point_t & start,
+		const point_t & control,
+		const point_t & point
+		){
+	//the second derivative is 2*(p0 - 2p1 + p2) everywhere
+	return hypotf(
+				start.x - 2*control.x + point.x,
+				start.y - 2*control.y + point.y
+				) / 4.0f;
+}
+
+float PathGeometry::calculate_cubic_bend(
+		const point_t & start,
+		const point_t & control0,
+		const point_t & control1,
+		const point_t & point
+		){
+	//the second derivative is at most 6 times the larger second difference
+	const float first = hypotf(
+				start.x - 2*control0.x + control1.x,
+				start.y - 2*control0.y + control1.y
+				);
+	const float second = hypotf(
+				control0.x - 2*control1.x + point.x,
+				control0.y - 2*control1.y + point.y
+				);
+	return (first > second ? first : second) * 3.0f / 4.0f;
+}
+
+void PathGeometry::add_quadratic(const point_t & control, const point_t & point){
+	const point_t start = m_current;
+	u32 steps = calculate_steps(calculate_quadratic_bend(start, control, point), m_tolerance);
+	m_curve_count++;
+
+	for(u32 i = 1; i <= steps; i++){
+		float t = 1.0f * i / steps;
+		float u = 1.0f - t;
+		point_t p;
+		p.x = u*u*start.x + 2*u*t*control.x + t*t*point.x;
+		p.y = u*u*start.y + 2*u*t*control.y + t*t*point.y;
+		line_to(p);
+	}
+}
+
+void PathGeometry::add_cubic(
+		const point_t & control0,
+		const point_t & control1,
+		const point_t & point
+		){
+	const point_t start = m_current;
+	u32 steps = calculate_steps(
+				calculate_cubic_bend(start, control0, control1, point),
+				m_tolerance
+				);
+	m_curve_count++;
+
+	for(u32 i = 1; i <= steps; i++){
+		float t = 1.0f * i / steps;
+		float u = 1.0f - t;
+		point_t p;
+		p.x = u*u*u*start.x + 3*u*u*t*control0.x + 3*u*t*t*control1.x + t*t*t*point.x;
+		p.y = u*u*u*start.y + 3*u*u*t*control0.y + 3*u*t*t*control1.y + t*t*t*point.y;
+		line_to(p);
+	}
+}
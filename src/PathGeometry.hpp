@@ -0,0 +1,144 @@
+/*! \file */ //Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+
+#ifndef PATHGEOMETRY_HPP_
+#define PATHGEOMETRY_HPP_
+
+#include <sapi/var.hpp>
+#include <sapi/sgfx.hpp>
+
+/*! \details Flattens a vector path into line segments in bitmap space.
+ *
+ * The elements produced by SvgFontManager::process_svg_path() are
+ * mapped to \a region the same way sgfx::Vector::draw() maps them
+ * with a VectorMap calculated for that region (no rotation), but
+ * the coordinates are kept as floats. Each curve is split into the
+ * fewest evenly spaced segments that stay within the tolerance (from
+ * the bound on its second derivative), so a flat curve is one segment
+ * and the count follows the output resolution rather than the length
+ * of the curve. Every sub-path is closed so the segments describe a
+ * fillable outline and each one keeps the direction of the path
+ * (needed for the non-zero winding rule).
+ *
+ * Pour elements are ignored.
+ *
+ */
+class PathGeometry {
+public:
+	PathGeometry();
+
+	typedef struct {
+		float x0;
+		float y0;
+		float x1;
+		float y1;
+	} segment_t;
+
+	/*! \details Replaces the segments with the flattened \a elements.
+	 *
+	 * Returns the number of segments.
+	 *
+	 */
+	u32 flatten(
+			const var::Vector<sg_vector_path_description_t> & elements,
+			const Region & region
+			);
+
+	const var::Vector<segment_t> & segments() const { return m_segments; }
+
+	/*! \details Returns \a elements with each curve replaced by line elements.
+	 *
+	 * The number of lines per curve is chosen the same way flatten()
+	 * chooses segments when the path is drawn on \a region. The points
+	 * stay in vector space (curve end points are kept exactly) so the
+	 * result can be drawn with sgfx::Vector::draw() instead of the
+	 * curves. curve_count() is the number of curves that were replaced.
+	 *
+	 */
+	var::Vector<sg_vector_path_description_t> flatten_to_lines(
+			const var::Vector<sg_vector_path_description_t> & elements,
+			const Region & region
+			);
+
+	enum {
+		STEPS_MAX = 64 //segments per curve
+	};
+
+	/*! \details Default distance in pixels allowed between a curve and its segments. */
+	static constexpr float DEFAULT_TOLERANCE = 0.25f;
+	static constexpr float MINIMUM_TOLERANCE = 0.01f;
+
+	/*! \details Sets the largest distance in pixels between a curve and its
+	 * segments for the next flatten().
+	 */
+	void set_tolerance(float value);
+	float tolerance() const { return m_tolerance; }
+
+	/*! \details Returns the number of curves split by the last flatten(). */
+	u32 curve_count() const { return m_curve_count; }
+
+	typedef struct {
+		float x_min;
+		float y_min;
+		float x_max;
+		float y_max;
+	} bounds_t;
+
+	/*! \details Calculates the bounding box of \a elements in vector coordinates.
+	 *
+	 * Curves contribute their end points and the extrema found where
+	 * the derivative is zero (not the control points), so the box is
+	 * tight. A move only counts if something is drawn from it. Returns
+	 * false if the path draws nothing.
+	 *
+	 */
+	static bool calculate_bounds(
+			const var::Vector<sg_vector_path_description_t> & elements,
+			bounds_t & bounds
+			);
+
+	/*! \details Returns the pixels of \a region covered by vector \a bounds.
+	 *
+	 * The result is clipped to \a region and is empty if the bounds
+	 * fall outside of it.
+	 *
+	 */
+	static Region map_bounds(const bounds_t & bounds, const Region & region);
+
+	/*! \details Returns the pixels touched by the segments.
+	 *
+	 * The region is clipped to the region the path was mapped to. It
+	 * is empty if there are no segments.
+	 *
+	 */
+	Region calculate_pixel_bounds() const;
+
+private:
+	typedef struct {
+		float x;
+		float y;
+	} point_t;
+
+	point_t map_point(const sg_point_t & point) const;
+	static point_t map_point(float x, float y, const Region & region);
+	static Region clip_pixels(int left, int top, int right, int bottom, const Region & region);
+	static void include_point(bounds_t & bounds, float x, float y);
+	static void include_extremum(bounds_t & bounds, float a, float b, float c, const float * x, const float * y, u32 order);
+	void line_to(const point_t & point);
+	void close_path();
+	void add_quadratic(const point_t & control, const point_t & point);
+	void add_cubic(const point_t & control0, const point_t & control1, const point_t & point);
+	static u32 calculate_steps(float bend, float tolerance);
+	static float calculate_quadratic_bend(const point_t & start, const point_t & control, const point_t & point);
+	static float calculate_cubic_bend(const point_t & start, const point_t & control0, const point_t & control1, const point_t & point);
+
+	Region m_region;
+	float m_tolerance;
+	u32 m_curve_count;
+	point_t m_start;
+	point_t m_current;
+	bool m_is_open;
+	var::Vector<segment_t> m_segments;
+};
+
+#endif /* PATHGEOMETRY_HPP_ */
@@ -0,0 +1,262 @@
+/*! \file */ //Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+#include "RegionMap.hpp"
+#include "RunTable.hpp"
+
+RegionMap::RegionMap(){
+	m_width = 0;
+	m_height = 0;
+	m_region_count = 0;
+	m_is_pixel_map = true;
+}
+
+RegionMap::RegionMap(const sgfx::Bitmap & bitmap){
+	calculate(bitmap);
+}
+
+void RegionMap::calculate(const sgfx::Bitmap & bitmap, bool is_pixel_map){
+	calculate(RunTable(bitmap), is_pixel_map);
+}
+
+void RegionMap::calculate(const RunTable & run_table, bool is_pixel_map){
+	m_width = run_table.width();
+	m_height = run_table.height();
+	m_region_count = 0;
+	m_is_pixel_map = is_pixel_map;
+	if( is_pixel_map ){
+		m_labels.resize(m_width * m_height);
+	}
+	m_runs.resize(0);
+	m_bounds.resize(1); //no bounds for FOREGROUND
+
+	//first run on each line plus one entry to mark the end
+	var::Vector<u32> & line_start = m_line_start;
+	line_start.resize(m_height + 1);
+
+	for(u32 y = 0; y < m_height; y++){
+		line_start.at(y) = m_runs.count();
+
+		//background runs are the gaps between the set runs
+		const RowScanner::run_t * set_run = run_table.begin(y);
+		const RowScanner::run_t * set_end = run_table.end(y);
+		u32 x = 0;
+		for(; ; set_run++){
+			const u32 end = set_run < set_end ? set_run->start : m_width;
+			if( end > x ){
+				run_t run;
+				run.x = x;
+				run.width = end - x;
+				run.parent = m_runs.count();
+				m_runs.push_back(run);
+			}
+			if( set_run == set_end ){
+				break;
+			}
+			x = set_run->end;
+		}
+
+		if( y == 0 ){
+			continue;
+		}
+
+		//join with runs on the previous line that share a column
+		u32 above = line_start.at(y-1);
+		u32 above_end = line_start.at(y);
+		for(u32 current = above_end; current < m_runs.count(); current++){
+			const u32 start = m_runs.at(current).x;
+			const u32 end = start + m_runs.at(current).width;
+			while( (above < above_end) &&
+					 (m_runs.at(above).x + m_runs.at(above).width <= start) ){
+				above++;
+			}
+
+			for(u32 i = above;
+				 (i < above_end) && (m_runs.at(i).x < end);
+				 i++){
+				join(current, i);
+			}
+		}
+	}
+	line_start.at(m_height) = m_runs.count();
+
+	//labels are numbered in scan order starting at 1
+	var::Vector<u32> & root_label = m_root_label;
+	root_label.resize(m_runs.count());
+	for(auto & value: root_label){
+		value = 0;
+	}
+
+	m_run_labels.resize(m_runs.count());
+	for(u32 y = 0; y < m_height; y++){
+		u32 * line = 0;
+		if( is_pixel_map ){
+			line = &m_labels.at(y * m_width);
+			for(u32 x = 0; x < m_width; x++){
+				line[x] = FOREGROUND;
+			}
+		}
+
+		for(u32 i = line_start.at(y); i < line_start.at(y+1); i++){
+			u32 root = find_root(i);
+			const run_t & run = m_runs.at(i);
+			const u16 right = run.x + run.width;
+			if( root_label.at(root) == 0 ){
+				root_label.at(root) = ++m_region_count;
+				bounds_t bounds;
+				bounds.left = run.x;
+				bounds.top = y;
+				bounds.right = right;
+				bounds.bottom = y + 1;
+				m_bounds.push_back(bounds);
+			}
+
+			const u32 label = root_label.at(root);
+			bounds_t & bounds = m_bounds.at(label);
+			if( run.x < bounds.left ){ bounds.left = run.x; }
+			if( right > bounds.right ){ bounds.right = right; }
+			bounds.bottom = y + 1;
+			m_run_labels.at(i) = label;
+
+			if( line ){
+				for(u32 x = run.x; x < right; x++){
+					line[x] = label;
+				}
+			}
+		}
+	}
+
+	if( is_pixel_map ){
+		calculate_y_spacing();
+	}
+}
+
+sgfx::Region RegionMap::bounds(u32 label) const {
+	if( (label == FOREGROUND) || (label > m_region_count) ){
+		return sgfx::Region();
+	}
+	const bounds_t & value = m_bounds.at(label);
+	return sgfx::Region(
+				sgfx::Point(value.left, value.top),
+				sgfx::Area(value.right - value.left, value.bottom - value.top)
+				);
+}
+
+u32 RegionMap::find_run_label(u32 x, u32 y) const {
+	//last run on the line that starts at or before x
+	u32 low = m_line_start.at(y);
+	u32 high = m_line_start.at(y+1);
+	while( low < high ){
+		u32 middle = (low + high) / 2;
+		if( m_runs.at(middle).x <= x ){
+			low = middle + 1;
+		} else {
+			high = middle;
+		}
+	}
+
+	if( low == m_line_start.at(y) ){
+		return FOREGROUND;
+	}
+	const run_t & run = m_runs.at(low - 1);
+	return x < (u32)run.x + run.width ? m_run_labels.at(low - 1) : (u32)FOREGROUND;
+}
+
+sg_size_t RegionMap::find_y_spacing(u32 x, u32 y) const {
+	//the same clearance calculate_y_spacing() stores for every pixel
+	if( find_run_label(x, y) == FOREGROUND ){
+		return 1;
+	}
+
+	u32 below = 0;
+	for(u32 row = y + 1; row < m_height; row++){
+		if( find_run_label(x, row) == FOREGROUND ){
+			below = row - y + 1;
+			break;
+		}
+	}
+
+	u32 above = 0;
+	if( y == 0 ){
+		above = 1;
+	} else {
+		//the top row is not checked
+		for(u32 row = y - 1; row > 0; row--){
+			if( find_run_label(x, row) == FOREGROUND ){
+				above = y - row + 1;
+				break;
+			}
+		}
+	}
+
+	if( (above == 0) || (below == 0) ){
+		return 0;
+	}
+	return above < below ? above : below;
+}
+
+void RegionMap::calculate_y_spacing(){
+	m_y_spacing.resize(m_width * m_height);
+
+	for(u32 x = 0; x < m_width; x++){
+		//distance to the nearest set pixel below (0 if there is none)
+		u32 below = 0;
+		for(u32 y = m_height; y > 0; y--){
+			if( m_labels.at((y-1) * m_width + x) == FOREGROUND ){
+				below = 1;
+			} else if( below ){
+				below++;
+			}
+			m_y_spacing.at((y-1) * m_width + x) = below;
+		}
+
+		//distance to the nearest set pixel above -- the top row is not checked
+		u32 above = 0;
+		for(u32 y = 0; y < m_height; y++){
+			const u32 offset = y * m_width + x;
+			if( (m_labels.at(offset) == FOREGROUND) || (y == 0) ){
+				above = 1;
+			} else if( y == 1 ){
+				above = 0;
+			} else if( above ){
+				above++;
+			}
+
+			below = m_y_spacing.at(offset);
+			if( (above == 0) || (below == 0) ){
+				m_y_spacing.at(offset) = 0;
+			} else {
+				m_y_spacing.at(offset) = above < below ? above : below;
+			}
+		}
+	}
+}
+
+u32 RegionMap::find_root(u32 run){
+	u32 root = run;
+	while( m_runs.at(root).parent != root ){
+		root = m_runs.at(root).parent;
+	}
+
+	//compress the path so later lookups are direct
+	while( m_runs.at(run).parent != root ){
+		u32 next = m_runs.at(run).parent;
+		m_runs.at(run).parent = root;
+		run = next;
+	}
+	return root;
+}
+
+void RegionMap::join(u32 a, u32 b){
+	u32 root_a = find_root(a);
+	u32 root_b = find_root(b);
+	if( root_a == root_b ){
+		return;
+	}
+
+	//the older run stays the root
+	if( root_a < root_b ){
+		m_runs.at(root_b).parent = root_a;
+	} else {
+		m_runs.at(root_a).parent = root_b;
+	}
+}
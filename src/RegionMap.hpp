@@ -0,0 +1,128 @@
+/*! \file */ //Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+
+#ifndef REGIONMAP_HPP_
+#define REGIONMAP_HPP_
+
+#include <sapi/var.hpp>
+#include <sapi/sgfx.hpp>
+
+class RunTable;
+
+/*! \details Labels the connected background regions of a bitmap.
+ *
+ * Every pixel with a value of zero gets the label of the
+ * 4-connected region it belongs to -- the same pixels that
+ * Bitmap::draw_pour() would fill from any point in that region.
+ * Pixels that are set have the label FOREGROUND.
+ *
+ * The set runs of each row come from a RunTable. Runs of background
+ * pixels are joined with the overlapping runs on the previous line
+ * using union-find, so labeling costs about the same as one flood
+ * fill but answers "would a pour from A reach B" for any pair of
+ * points.
+ *
+ * The vertical clearance of each pixel (used to pick the pour point
+ * of a group) is computed in the same pass.
+ *
+ */
+class RegionMap {
+public:
+	RegionMap();
+	RegionMap(const sgfx::Bitmap & bitmap);
+
+	/*! \details Labels \a bitmap reusing the memory of the previous labels.
+	 *
+	 * If \a is_pixel_map is false, only the runs are labeled. Nothing
+	 * is stored per pixel, so the cost depends on the number of runs
+	 * instead of the area. label() then searches the runs of the row
+	 * and y_spacing() walks the column.
+	 *
+	 */
+	void calculate(const sgfx::Bitmap & bitmap, bool is_pixel_map = true);
+
+	/*! \details Labels the bitmap that \a run_table was read from. */
+	void calculate(const RunTable & run_table, bool is_pixel_map = true);
+
+	enum {
+		FOREGROUND = 0
+	};
+
+	/*! \details Returns the label at \a point (FOREGROUND if the point is set or out of bounds). */
+	u32 label(const sgfx::Point & point) const {
+		if( (point.x() < 0) || (point.y() < 0) ||
+			 ((u32)point.x() >= m_width) || ((u32)point.y() >= m_height) ){
+			return FOREGROUND;
+		}
+		if( m_is_pixel_map == false ){
+			return find_run_label(point.x(), point.y());
+		}
+		return m_labels.at(point.y() * m_width + point.x());
+	}
+
+	bool is_foreground(const sgfx::Point & point) const {
+		return label(point) == FOREGROUND;
+	}
+
+	/*! \details Returns the vertical clearance at \a point.
+	 *
+	 * This is the number of pixels from \a point to the nearest set
+	 * pixel above or below it (counting the set pixel). It is zero if
+	 * the column is open above or below the point. The top row is never
+	 * treated as set.
+	 *
+	 */
+	sg_size_t y_spacing(const sgfx::Point & point) const {
+		if( (point.x() < 0) || (point.y() < 0) ||
+			 ((u32)point.x() >= m_width) || ((u32)point.y() >= m_height) ){
+			return 0;
+		}
+		if( m_is_pixel_map == false ){
+			return find_y_spacing(point.x(), point.y());
+		}
+		return m_y_spacing.at(point.y() * m_width + point.x());
+	}
+
+	/*! \details Returns the number of background regions. */
+	u32 region_count() const { return m_region_count; }
+
+	u32 width() const { return m_width; }
+	u32 height() const { return m_height; }
+
+	/*! \details Returns the smallest region that holds every pixel with \a label. */
+	sgfx::Region bounds(u32 label) const;
+
+private:
+	typedef struct {
+		u16 x;
+		u16 width;
+		u32 parent;
+	} run_t;
+
+	typedef struct {
+		u16 left;
+		u16 top;
+		u16 right;
+		u16 bottom;
+	} bounds_t;
+
+	u32 find_root(u32 run);
+	u32 find_run_label(u32 x, u32 y) const;
+	sg_size_t find_y_spacing(u32 x, u32 y) const;
+	void join(u32 a, u32 b);
+	void calculate_y_spacing();
+
+	u32 m_width;
+	u32 m_height;
+	u32 m_region_count;
+	bool m_is_pixel_map;
+	var::Vector<run_t> m_runs;
+	var::Vector<u32> m_line_start;
+	var::Vector<u32> m_root_label;
+	var::Vector<u32> m_run_labels;
+	var::Vector<bounds_t> m_bounds; //indexed by label
+	var::Vector<u32> m_labels;
+	var::Vector<sg_size_t> m_y_spacing;
+};
+
+#endif /* REGIONMAP_HPP_ */
@@ -0,0 +1,318 @@
+/*! \file */ //Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+#include <cstring>
+#include "RowScanner.hpp"
+
+#if defined __link && defined __GNUC__ && (defined __x86_64__ || defined __i386__)
+#include <immintrin.h>
+#define HAS_X86_KERNELS 1
+#endif
+
+namespace {
+
+u32 count_trailing_zeros(u64 value){
+	return __builtin_ctzll(value);
+}
+
+//log2 of the bits per pixel -- false if the word kernel cannot read it
+bool get_pixel_shift(u8 bits_per_pixel, u32 & shift){
+	switch(bits_per_pixel){
+		case 1: shift = 0; return true;
+		case 2: shift = 1; return true;
+		case 4: shift = 2; return true;
+		case 8: shift = 3; return true;
+	}
+	return false;
+}
+
+#if defined HAS_X86_KERNELS
+//one bit per non-zero byte for 64 bytes
+__attribute__((target("sse2")))
+u64 get_mask_sse2(const u8 * data){
+	const __m128i zero = _mm_setzero_si128();
+	u64 result = 0;
+	for(u32 i=0; i < 4; i++){
+		__m128i value = _mm_loadu_si128((const __m128i*)(data + i*16));
+		u32 is_zero = (u32)_mm_movemask_epi8(_mm_cmpeq_epi8(value, zero));
+		result |= (u64)(~is_zero & 0xffff) << (i*16);
+	}
+	return result;
+}
+
+__attribute__((target("avx2")))
+u64 get_mask_avx2(const u8 * data){
+	const __m256i zero = _mm256_setzero_si256();
+	__m256i low = _mm256_loadu_si256((const __m256i*)data);
+	__m256i high = _mm256_loadu_si256((const __m256i*)(data + 32));
+	u32 low_zero = (u32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(low, zero));
+	u32 high_zero = (u32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(high, zero));
+	return ~(((u64)high_zero << 32) | low_zero);
+}
+#endif
+
+}
+
+RowScanner::RowScanner(const sgfx::Bitmap & bitmap) :
+	RowScanner(bitmap, get_default_kernel(bitmap.bits_per_pixel())){}
+
+RowScanner::RowScanner(
+		const sgfx::Bitmap & bitmap,
+		enum kernel kernel
+		) : m_bitmap(bitmap){
+	m_width = bitmap.width();
+	m_height = bitmap.height();
+	m_bits_per_pixel = bitmap.bits_per_pixel();
+	m_data = (const u8*)bitmap.data();
+	m_stride = m_height ? bitmap.size() / m_height : 0;
+	m_row_bytes = ((u32)m_width * m_bits_per_pixel + 7) / 8;
+
+	if( (is_kernel_supported(kernel, m_bits_per_pixel) == false) ||
+		 (m_data == 0) ||
+		 (m_stride < m_row_bytes) ){
+		kernel = KERNEL_PIXEL;
+	}
+	m_kernel = kernel;
+}
+
+enum RowScanner::kernel RowScanner::get_default_kernel(u8 bits_per_pixel){
+	if( is_kernel_supported(KERNEL_AVX2, bits_per_pixel) ){
+		return KERNEL_AVX2;
+	}
+	if( is_kernel_supported(KERNEL_SSE2, bits_per_pixel) ){
+		return KERNEL_SSE2;
+	}
+	if( is_kernel_supported(KERNEL_WORD, bits_per_pixel) ){
+		return KERNEL_WORD;
+	}
+	return KERNEL_PIXEL;
+}
+
+bool RowScanner::is_kernel_supported(enum kernel kernel, u8 bits_per_pixel){
+	u32 shift;
+	switch(kernel){
+		case KERNEL_PIXEL:
+			return true;
+		case KERNEL_WORD:
+			return get_pixel_shift(bits_per_pixel, shift);
+#if defined HAS_X86_KERNELS
+		case KERNEL_SSE2:
+			return (bits_per_pixel == 8) && __builtin_cpu_supports("sse2");
+		case KERNEL_AVX2:
+			return (bits_per_pixel == 8) && __builtin_cpu_supports("avx2");
+#endif
+		default:
+			return false;
+	}
+}
+
+const char * RowScanner::get_kernel_name(enum kernel kernel){
+	switch(kernel){
+		case KERNEL_PIXEL: return "pixel";
+		case KERNEL_WORD: return "word";
+		case KERNEL_SSE2: return "sse2";
+		case KERNEL_AVX2: return "avx2";
+		default: return "unknown";
+	}
+}
+
+u32 RowScanner::scan(sg_int_t y, std::vector<run_t> & runs) const {
+	runs.clear();
+	return append(y, runs);
+}
+
+u32 RowScanner::append(sg_int_t y, std::vector<run_t> & runs) const {
+	if( (y < 0) || (y >= m_height) ){
+		return 0;
+	}
+
+	const u32 count = runs.size();
+
+	switch(m_kernel){
+		case KERNEL_WORD: {
+			state_t state;
+			state.is_set = false;
+			state.start = 0;
+			scan_words(m_data + y * m_stride, 0, state, runs);
+			finish_runs(m_width, state, runs);
+			break;
+		}
+		case KERNEL_SSE2:
+		case KERNEL_AVX2:
+			scan_sse2(y, runs);
+			break;
+		default:
+			scan_pixels(y, runs);
+			break;
+	}
+	return runs.size() - count;
+}
+
+u32 RowScanner::scan_column(sg_int_t x, std::vector<run_t> & runs) const {
+	runs.clear();
+	if( (x < 0) || (x >= m_width) ){
+		return 0;
+	}
+
+	state_t state;
+	state.is_set = false;
+	state.start = 0;
+	for(sg_int_t y = 0; y < m_height; y++){
+		bool is_pixel_set = is_set(sgfx::Point(x,y));
+		if( is_pixel_set == state.is_set ){
+			continue;
+		}
+		if( is_pixel_set ){
+			state.start = y;
+		} else {
+			run_t run;
+			run.start = state.start;
+			run.end = y;
+			runs.push_back(run);
+		}
+		state.is_set = is_pixel_set;
+	}
+	finish_runs(m_height, state, runs);
+	return runs.size();
+}
+
+bool RowScanner::is_set(const sgfx::Point & point) const {
+	if( m_kernel == KERNEL_PIXEL ){
+		return m_bitmap.get_pixel(point) != 0;
+	}
+
+	const u32 bit = (u32)point.x() * m_bits_per_pixel;
+	const u8 value = m_data[point.y() * m_stride + bit / 8] >> (bit % 8);
+	return (value & ((1 << m_bits_per_pixel) - 1)) != 0;
+}
+
+void RowScanner::scan_pixels(sg_int_t y, std::vector<run_t> & runs) const {
+	state_t state;
+	state.is_set = false;
+	state.start = 0;
+	for(sg_int_t x = 0; x < m_width; x++){
+		bool is_pixel_set = m_bitmap.get_pixel(sgfx::Point(x,y)) != 0;
+		if( is_pixel_set == state.is_set ){
+			continue;
+		}
+		if( is_pixel_set ){
+			state.start = x;
+		} else {
+			run_t run;
+			run.start = state.start;
+			run.end = x;
+			runs.push_back(run);
+		}
+		state.is_set = is_pixel_set;
+	}
+	finish_runs(m_width, state, runs);
+}
+
+void RowScanner::scan_words(
+		const u8 * row,
+		u32 x,
+		state_t & state,
+		std::vector<run_t> & runs
+		) const {
+	//bit 0 of each pixel
+	static const u64 lane_pattern[4] = {
+		0xffffffffffffffffULL,
+		0x5555555555555555ULL,
+		0x1111111111111111ULL,
+		0x0101010101010101ULL
+	};
+
+	u32 shift = 0;
+	get_pixel_shift(m_bits_per_pixel, shift);
+	const u32 pixels_per_word = 64 >> shift;
+
+	for(; x < m_width; x += pixels_per_word){
+		const u32 byte = (x << shift) / 8;
+		u32 count = m_row_bytes - byte;
+		if( count > 8 ){
+			count = 8;
+		}
+
+		u64 word = 0;
+		memcpy(&word, row + byte, count);
+
+		//fold each pixel onto its lowest bit
+		if( shift > 0 ){ word |= word >> 1; }
+		if( shift > 1 ){ word |= word >> 2; }
+		if( shift > 2 ){ word |= word >> 4; }
+
+		u64 lanes = lane_pattern[shift];
+		const u32 pixels = m_width - x;
+		if( pixels < pixels_per_word ){
+			lanes &= ((u64)1 << (pixels << shift)) - 1;
+		}
+
+		append_runs(word, lanes, x, shift, state, runs);
+	}
+}
+
+void RowScanner::scan_sse2(sg_int_t y, std::vector<run_t> & runs) const {
+	const u8 * row = m_data + y * m_stride;
+	state_t state;
+	state.is_set = false;
+	state.start = 0;
+
+	u32 x = 0;
+#if defined HAS_X86_KERNELS
+	//64 pixels per step then the word kernel finishes the row
+	const bool is_avx2 = m_kernel == KERNEL_AVX2;
+	for(; x + 64 <= m_width; x += 64){
+		u64 bits = is_avx2 ? get_mask_avx2(row + x) : get_mask_sse2(row + x);
+		append_runs(bits, ~(u64)0, x, 0, state, runs);
+	}
+#endif
+
+	scan_words(row, x, state, runs);
+	finish_runs(m_width, state, runs);
+}
+
+void RowScanner::append_runs(
+		u64 bits,
+		u64 lanes,
+		u32 x,
+		u32 shift,
+		state_t & state,
+		std::vector<run_t> & runs
+		){
+	bits &= lanes;
+	while( 1 ){
+		//the next pixel that differs from the current state
+		u64 search = state.is_set ? (lanes & ~bits) : bits;
+		if( search == 0 ){
+			return;
+		}
+
+		u32 bit = count_trailing_zeros(search);
+		sg_int_t position = x + (bit >> shift);
+		if( state.is_set ){
+			run_t run;
+			run.start = state.start;
+			run.end = position;
+			runs.push_back(run);
+		} else {
+			state.start = position;
+		}
+		state.is_set = !state.is_set;
+
+		lanes &= ~(((u64)1 << bit) - 1);
+		bits &= lanes;
+	}
+}
+
+void RowScanner::finish_runs(
+		sg_size_t width,
+		state_t & state,
+		std::vector<run_t> & runs
+		){
+	if( state.is_set ){
+		run_t run;
+		run.start = state.start;
+		run.end = width;
+		runs.push_back(run);
+		state.is_set = false;
+	}
+}
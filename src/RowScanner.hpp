@@ -0,0 +1,105 @@
+/*! \file */ //Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+
+#ifndef ROWSCANNER_HPP_
+#define ROWSCANNER_HPP_
+
+#include <vector>
+#include <sapi/var.hpp>
+#include <sapi/sgfx.hpp>
+
+/*! \details Finds the runs of set pixels on a bitmap row.
+ *
+ * The row is read directly from the bitmap memory a word at a time
+ * instead of through Bitmap::get_pixel(). Each word is reduced to a
+ * mask with one bit per pixel that is set and the run boundaries are
+ * found with count-trailing-zeros, so a row of background costs one
+ * test per 64 bits.
+ *
+ * - KERNEL_PIXEL calls Bitmap::get_pixel() (reference and fallback)
+ * - KERNEL_WORD works on 64-bit words for 1, 2, 4 and 8 bits per pixel
+ * - KERNEL_SSE2 and KERNEL_AVX2 compare 16 or 32 pixels at a time for
+ *   8 bits per pixel (x86 desktop builds, checked at run time)
+ *
+ * Pixels are assumed to be packed from the least significant bit of
+ * each little-endian word (the sgfx layout). If the bitmap memory is
+ * smaller than that layout needs, KERNEL_PIXEL is used.
+ *
+ * ```
+ * RowScanner scanner(bitmap);
+ * std::vector<RowScanner::run_t> runs;
+ * scanner.scan(y, runs);
+ * ```
+ *
+ */
+class RowScanner {
+public:
+
+	enum kernel {
+		KERNEL_PIXEL,
+		KERNEL_WORD,
+		KERNEL_SSE2,
+		KERNEL_AVX2,
+		KERNEL_TOTAL
+	};
+
+	/*! \details Set pixels from \a start up to (not including) \a end. */
+	typedef struct {
+		sg_int_t start;
+		sg_int_t end;
+	} run_t;
+
+	explicit RowScanner(const sgfx::Bitmap & bitmap);
+	RowScanner(const sgfx::Bitmap & bitmap, enum kernel kernel);
+
+	/*! \details Replaces \a runs with the set runs on row \a y.
+	 *
+	 * Returns the number of runs.
+	 *
+	 */
+	u32 scan(sg_int_t y, std::vector<run_t> & runs) const;
+
+	/*! \details Adds the set runs on row \a y to the end of \a runs.
+	 *
+	 * Returns the number of runs added.
+	 *
+	 */
+	u32 append(sg_int_t y, std::vector<run_t> & runs) const;
+
+	/*! \details Replaces \a runs with the set runs on column \a x. */
+	u32 scan_column(sg_int_t x, std::vector<run_t> & runs) const;
+
+	bool is_set(const sgfx::Point & point) const;
+
+	enum kernel kernel() const { return m_kernel; }
+	sg_size_t width() const { return m_width; }
+	sg_size_t height() const { return m_height; }
+
+	/*! \details Returns the fastest kernel available for \a bits_per_pixel. */
+	static enum kernel get_default_kernel(u8 bits_per_pixel);
+	static bool is_kernel_supported(enum kernel kernel, u8 bits_per_pixel);
+	static const char * get_kernel_name(enum kernel kernel);
+
+private:
+	typedef struct {
+		bool is_set;
+		sg_int_t start;
+	} state_t;
+
+	void scan_pixels(sg_int_t y, std::vector<run_t> & runs) const;
+	void scan_words(const u8 * row, u32 x, state_t & state, std::vector<run_t> & runs) const;
+	void scan_sse2(sg_int_t y, std::vector<run_t> & runs) const;
+	static void append_runs(u64 bits, u64 lanes, u32 x, u32 shift, state_t & state, std::vector<run_t> & runs);
+	static void finish_runs(sg_size_t width, state_t & state, std::vector<run_t> & runs);
+
+	const sgfx::Bitmap & m_bitmap;
+	const u8 * m_data;
+	u32 m_stride; //bytes per row
+	u32 m_row_bytes; //bytes per row that hold pixels
+	sg_size_t m_width;
+	sg_size_t m_height;
+	u8 m_bits_per_pixel;
+	enum kernel m_kernel;
+};
+
+#endif /* ROWSCANNER_HPP_ */
@@ -0,0 +1,77 @@
+/*! \file */ //Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+#include "RunTable.hpp"
+
+RunTable::RunTable(){
+	m_width = 0;
+	m_height = 0;
+	m_row_start.resize(1);
+	m_row_start.at(0) = 0;
+}
+
+RunTable::RunTable(const sgfx::Bitmap & bitmap){
+	calculate(bitmap);
+}
+
+void RunTable::calculate(const sgfx::Bitmap & bitmap){
+	m_width = bitmap.width();
+	m_height = bitmap.height();
+	m_runs.clear();
+	m_row_start.resize(m_height + 1);
+
+	RowScanner scanner(bitmap);
+	for(u32 y = 0; y < m_height; y++){
+		m_row_start.at(y) = m_runs.size();
+		scanner.append(y, m_runs);
+	}
+	m_row_start.at(m_height) = m_runs.size();
+}
+
+bool RunTable::is_set(const sgfx::Point & point) const {
+	if( (point.x() < 0) || (point.x() >= m_width) ){
+		return false;
+	}
+
+	//first run that ends after x
+	const RowScanner::run_t * low = begin(point.y());
+	const RowScanner::run_t * high = end(point.y());
+	while( low < high ){
+		const RowScanner::run_t * middle = low + (high - low) / 2;
+		if( middle->end <= point.x() ){
+			low = middle + 1;
+		} else {
+			high = middle;
+		}
+	}
+
+	return (low < end(point.y())) && (low->start <= point.x());
+}
+
+u32 RunTable::scan_column(sg_int_t x, std::vector<RowScanner::run_t> & runs) const {
+	runs.clear();
+	if( (x < 0) || (x >= m_width) ){
+		return 0;
+	}
+
+	RowScanner::run_t run;
+	bool is_in_run = false;
+	for(sg_int_t y = 0; y < m_height; y++){
+		bool is_pixel_set = is_set(sgfx::Point(x,y));
+		if( is_pixel_set == is_in_run ){
+			continue;
+		}
+		if( is_pixel_set ){
+			run.start = y;
+		} else {
+			run.end = y;
+			runs.push_back(run);
+		}
+		is_in_run = is_pixel_set;
+	}
+
+	if( is_in_run ){
+		run.end = m_height;
+		runs.push_back(run);
+	}
+	return runs.size();
+}
@@ -0,0 +1,72 @@
+/*! \file */ //Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+
+#ifndef RUNTABLE_HPP_
+#define RUNTABLE_HPP_
+
+#include <vector>
+#include <sapi/var.hpp>
+#include <sapi/sgfx.hpp>
+#include "RowScanner.hpp"
+
+/*! \details The set runs of every row of a bitmap.
+ *
+ * The bitmap is read once with RowScanner and the runs of all rows
+ * are kept back to back in one array with the index of the first run
+ * of each row. The fill stage (candidate searches, region labels,
+ * distances and inside tests) reads the rows from the table instead
+ * of scanning the canvas again.
+ *
+ * ```
+ * RunTable table(bitmap);
+ * for(const RowScanner::run_t * run = table.begin(y); run < table.end(y); run++){
+ *   //set pixels from run->start to run->end
+ * }
+ * ```
+ *
+ */
+class RunTable {
+public:
+	RunTable();
+	explicit RunTable(const sgfx::Bitmap & bitmap);
+
+	/*! \details Replaces the runs with those of \a bitmap reusing the memory. */
+	void calculate(const sgfx::Bitmap & bitmap);
+
+	/*! \details Returns the first run of row \a y (rows outside the table are empty). */
+	const RowScanner::run_t * begin(sg_int_t y) const {
+		return m_runs.data() + (is_row(y) ? m_row_start.at(y) : 0);
+	}
+
+	/*! \details Returns the run after the last one of row \a y. */
+	const RowScanner::run_t * end(sg_int_t y) const {
+		return m_runs.data() + (is_row(y) ? m_row_start.at(y+1) : 0);
+	}
+
+	u32 run_count(sg_int_t y) const { return end(y) - begin(y); }
+
+	/*! \details Returns true if the pixel at \a point is in a run. */
+	bool is_set(const sgfx::Point & point) const;
+
+	/*! \details Replaces \a runs with the set runs on column \a x. */
+	u32 scan_column(sg_int_t x, std::vector<RowScanner::run_t> & runs) const;
+
+	sg_size_t width() const { return m_width; }
+	sg_size_t height() const { return m_height; }
+	sgfx::Area area() const { return sgfx::Area(m_width, m_height); }
+
+	/*! \details Returns the number of runs in the table. */
+	u32 count() const { return m_runs.size(); }
+
+private:
+	bool is_row(sg_int_t y) const {
+		return (y >= 0) && (y < m_height);
+	}
+
+	sg_size_t m_width;
+	sg_size_t m_height;
+	std::vector<RowScanner::run_t> m_runs; //rows back to back
+	var::Vector<u32> m_row_start; //first run of each row (one extra entry)
+};
+
+#endif /* RUNTABLE_HPP_ */
@@ -0,0 +1,196 @@
+/*! \file */ //Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "ScanlineRasterizer.hpp"
+
+ScanlineRasterizer::ScanlineRasterizer(
+		const PathGeometry & geometry,
+		enum fill_rule rule
+		){
+	m_fill_rule = rule;
+
+	std::vector<edge_t> edges;
+	for(const auto & segment: geometry.segments()){
+		//horizontal segments never cross a row center
+		if( segment.y0 == segment.y1 ){
+			continue;
+		}
+
+		edge_t edge;
+		if( segment.y0 < segment.y1 ){
+			edge.y_top = segment.y0;
+			edge.y_bottom = segment.y1;
+			edge.x_top = segment.x0;
+			edge.winding = 1;
+		} else {
+			edge.y_top = segment.y1;
+			edge.y_bottom = segment.y0;
+			edge.x_top = segment.x1;
+			edge.winding = -1;
+		}
+		edge.slope = (segment.x1 - segment.x0) / (segment.y1 - segment.y0);
+		edges.push_back(edge);
+	}
+
+	std::sort(
+				edges.begin(),
+				edges.end(),
+				[](const edge_t & a, const edge_t & b){
+		return a.y_top < b.y_top;
+	}
+	);
+
+	m_edges.resize(edges.size());
+	for(u32 i=0; i < edges.size(); i++){
+		m_edges.at(i) = edges.at(i);
+	}
+}
+
+void ScanlineRasterizer::calculate_crossings(
+		float y_center,
+		u32 & next_edge,
+		std::vector<u32> & active,
+		std::vector<crossing_t> & crossings
+		) const {
+
+	while( (next_edge < m_edges.count()) &&
+			 (m_edges.at(next_edge).y_top <= y_center) ){
+		active.push_back(next_edge++);
+	}
+
+	//an edge covers y_top <= y < y_bottom so shared vertices count once
+	crossings.clear();
+	u32 keep = 0;
+	for(u32 i=0; i < active.size(); i++){
+		const edge_t & edge = m_edges.at(active.at(i));
+		if( edge.y_bottom <= y_center ){
+			continue;
+		}
+		active.at(keep++) = active.at(i);
+		crossing_t crossing;
+		crossing.x = edge.x_top + (y_center - edge.y_top) * edge.slope;
+		crossing.winding = edge.winding;
+		crossings.push_back(crossing);
+	}
+	active.resize(keep);
+
+	std::sort(
+				crossings.begin(),
+				crossings.end(),
+				[](const crossing_t & a, const crossing_t & b){
+		return a.x < b.x;
+	}
+	);
+}
+
+u32 ScanlineRasterizer::fill(Bitmap & bitmap) const {
+	if( m_edges.count() == 0 ){
+		return 0;
+	}
+
+	std::vector<u32> active;
+	std::vector<crossing_t> crossings;
+	u32 next_edge = 0;
+	u32 pixel_count = 0;
+
+	int y_start = (int)ceilf(m_edges.at(0).y_top - 0.5f);
+	if( y_start < 0 ){
+		y_start = 0;
+	}
+
+	for(int y = y_start; y < bitmap.height(); y++){
+		//rows are sampled at the pixel centers
+		calculate_crossings(y + 0.5f, next_edge, active, crossings);
+		if( active.empty() && (next_edge == m_edges.count()) ){
+			break;
+		}
+
+		int winding = 0;
+		for(u32 i=0; i + 1 < crossings.size(); i++){
+			winding += crossings.at(i).winding;
+			if( is_inside(winding) == false ){
+				continue;
+			}
+
+			//pixels whose centers are between the crossings
+			int x_start = (int)ceilf(crossings.at(i).x - 0.5f);
+			int x_end = (int)ceilf(crossings.at(i+1).x - 0.5f);
+			if( x_start < 0 ){ x_start = 0; }
+			if( x_end > bitmap.width() ){ x_end = bitmap.width(); }
+			if( x_end > x_start ){
+				bitmap.draw_rectangle(Point(x_start, y), Area(x_end - x_start, 1));
+				pixel_count += x_end - x_start;
+			}
+		}
+	}
+
+	return pixel_count;
+}
+
+void ScanlineRasterizer::fill_coverage(
+		Bitmap & bitmap,
+		const Point & origin,
+		const Area & factor
+		) const {
+	if( (m_edges.count() == 0) || (factor.width() == 0) || (factor.height() == 0) ){
+		return;
+	}
+
+	std::vector<u32> active;
+	std::vector<crossing_t> crossings;
+	std::vector<u32> coverage(bitmap.width());
+	u32 next_edge = 0;
+
+	const int block_width = factor.width();
+	const int sample_width = bitmap.width() * block_width;
+	const u32 sample_count = factor.width() * factor.height();
+	const u32 color_max = (1 << bitmap.bits_per_pixel()) - 1;
+
+	for(int y = 0; y < bitmap.height(); y++){
+		for(auto & value: coverage){
+			value = 0;
+		}
+
+		for(u32 row = 0; row < factor.height(); row++){
+			const float y_center = origin.y() + y * factor.height() + row + 0.5f;
+			calculate_crossings(y_center, next_edge, active, crossings);
+
+			int winding = 0;
+			for(u32 i=0; i + 1 < crossings.size(); i++){
+				winding += crossings.at(i).winding;
+				if( is_inside(winding) == false ){
+					continue;
+				}
+
+				//sample columns inside the span relative to origin
+				int x_start = (int)ceilf(crossings.at(i).x - origin.x() - 0.5f);
+				int x_end = (int)ceilf(crossings.at(i+1).x - origin.x() - 0.5f);
+				if( x_start < 0 ){ x_start = 0; }
+				if( x_end > sample_width ){ x_end = sample_width; }
+
+				//whole blocks get the full row and the ends get a part
+				while( x_start < x_end ){
+					int block = x_start / block_width;
+					int block_end = (block + 1) * block_width;
+					if( block_end > x_end ){
+						block_end = x_end;
+					}
+					coverage.at(block) += block_end - x_start;
+					x_start = block_end;
+				}
+			}
+		}
+
+		for(int x = 0; x < bitmap.width(); x++){
+			if( coverage.at(x) ){
+				sg_color_t color = (coverage.at(x) * color_max + sample_count/2) / sample_count;
+				if( color ){
+					bitmap.set_pen( Pen().set_color(color) );
+					bitmap.draw_pixel(Point(x, y));
+				}
+			}
+		}
+	}
+}
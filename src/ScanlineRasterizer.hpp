@@ -0,0 +1,94 @@
+/*! \file */ //Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+
+#ifndef SCANLINERASTERIZER_HPP_
+#define SCANLINERASTERIZER_HPP_
+
+#include <vector>
+#include <sapi/var.hpp>
+#include <sapi/sgfx.hpp>
+#include "PathGeometry.hpp"
+
+/*! \details Fills a flattened path using a winding rule.
+ *
+ * The segments are sorted into an edge table. Each row is then
+ * filled between the crossings of the active edges at the pixel
+ * centers, so the path is filled in one pass without searching for
+ * pour points. Counters are left open by the winding rule instead
+ * of depending on where a pour starts.
+ *
+ * ```
+ * PathGeometry geometry;
+ * geometry.flatten(elements, canvas.get_viewable_region());
+ * ScanlineRasterizer(geometry).fill(canvas);
+ * ```
+ *
+ */
+class ScanlineRasterizer {
+public:
+
+	enum fill_rule {
+		FILL_RULE_NONZERO,
+		FILL_RULE_EVENODD
+	};
+
+	ScanlineRasterizer(
+			const PathGeometry & geometry,
+			enum fill_rule rule = FILL_RULE_NONZERO
+			);
+
+	/*! \details Fills the inside of the path on \a bitmap with the bitmap's pen.
+	 *
+	 * Returns the number of pixels that were filled.
+	 *
+	 */
+	u32 fill(Bitmap & bitmap) const;
+
+	/*! \details Draws the area coverage of the path on a reduced grid.
+	 *
+	 * Each pixel of \a bitmap covers \a factor pixels of the path's
+	 * space starting at \a origin. The pixel centers inside that block
+	 * are sampled (the same samples a full size fill followed by
+	 * Bitmap::downsample_bitmap() would count) and the covered fraction
+	 * is scaled to the bitmap's bits per pixel. No full size canvas is
+	 * needed. Pixels with no coverage are not drawn.
+	 *
+	 */
+	void fill_coverage(
+			Bitmap & bitmap,
+			const Point & origin,
+			const Area & factor
+			) const;
+
+private:
+	typedef struct {
+		float y_top;
+		float y_bottom;
+		float x_top; //x at y_top
+		float slope; //change in x per unit of y
+		s8 winding;
+	} edge_t;
+
+	typedef struct {
+		float x;
+		s8 winding;
+	} crossing_t;
+
+	void calculate_crossings(
+			float y_center,
+			u32 & next_edge,
+			std::vector<u32> & active,
+			std::vector<crossing_t> & crossings
+			) const;
+
+	enum fill_rule m_fill_rule;
+	var::Vector<edge_t> m_edges; //sorted by y_top
+
+	bool is_inside(int winding) const {
+		return m_fill_rule == FILL_RULE_NONZERO ?
+					winding != 0 :
+					(winding & 0x01) != 0;
+	}
+};
+
+#endif /* SCANLINERASTERIZER_HPP_ */
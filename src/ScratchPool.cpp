@@ -0,0 +1,102 @@
+/*! \file */ //Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+#include <utility>
+#include "ScratchPool.hpp"
+
+ScratchPool::ScratchPool(){
+	m_is_enabled = true;
+	m_allocation_count = 0;
+	m_acquire_count = 0;
+}
+
+ScratchPool & ScratchPool::get(){
+#if defined __link
+	static thread_local ScratchPool pool;
+#else
+	static ScratchPool pool;
+#endif
+	return pool;
+}
+
+void ScratchPool::set_enabled(bool value){
+	m_is_enabled = value;
+	if( value == false ){
+		//keep only what is in use
+		u32 keep = 0;
+		for(u32 i=0; i < m_entries.size(); i++){
+			if( m_entries.at(i).is_in_use ){
+				std::swap(m_entries.at(keep++), m_entries.at(i));
+			}
+		}
+		m_entries.resize(keep);
+	}
+}
+
+RunTable & ScratchPool::run_table(){
+	if( m_is_enabled == false ){
+		m_run_table = RunTable();
+		m_allocation_count++;
+	}
+	return m_run_table;
+}
+
+RegionMap & ScratchPool::region_map(){
+	if( m_is_enabled == false ){
+		m_region_map = RegionMap();
+		m_allocation_count++;
+	}
+	return m_region_map;
+}
+
+DistanceMap & ScratchPool::distance_map(){
+	if( m_is_enabled == false ){
+		m_distance_map = DistanceMap();
+		m_allocation_count++;
+	}
+	return m_distance_map;
+}
+
+CoordinateBatch & ScratchPool::coordinate_batch(){
+	if( m_is_enabled == false ){
+		m_coordinate_batch = CoordinateBatch();
+		m_allocation_count++;
+	}
+	return m_coordinate_batch;
+}
+
+sgfx::Bitmap & ScratchPool::acquire(const sgfx::Area & area, u8 bits_per_pixel){
+	m_acquire_count++;
+	if( m_is_enabled ){
+		for(auto & entry: m_entries){
+			if( (entry.is_in_use == false) &&
+				 (entry.bitmap->bits_per_pixel() == bits_per_pixel) &&
+				 (entry.bitmap->width() == area.width()) &&
+				 (entry.bitmap->height() == area.height()) ){
+				entry.is_in_use = true;
+				return *entry.bitmap;
+			}
+		}
+	}
+
+	entry_t entry;
+	entry.bitmap = std::unique_ptr<sgfx::Bitmap>(
+				new sgfx::Bitmap(area, sgfx::Bitmap::BitsPerPixel(bits_per_pixel))
+				);
+	entry.is_in_use = true;
+	m_allocation_count++;
+	m_entries.push_back(std::move(entry));
+	return *m_entries.back().bitmap;
+}
+
+void ScratchPool::release(sgfx::Bitmap & bitmap){
+	for(u32 i=0; i < m_entries.size(); i++){
+		if( m_entries.at(i).bitmap.get() == &bitmap ){
+			if( m_is_enabled ){
+				m_entries.at(i).is_in_use = false;
+			} else {
+				m_entries.erase(m_entries.begin() + i);
+			}
+			return;
+		}
+	}
+}
@@ -0,0 +1,116 @@
+/*! \file */ //Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+
+#ifndef SCRATCHPOOL_HPP_
+#define SCRATCHPOOL_HPP_
+
+#include <memory>
+#include <vector>
+#include <sapi/var.hpp>
+#include <sapi/sgfx.hpp>
+#include "RunTable.hpp"
+#include "RegionMap.hpp"
+#include "DistanceMap.hpp"
+#include "CoordinateBatch.hpp"
+
+/*! \details Reusable working memory for the fill point stage.
+ *
+ * Each thread has its own pool (see get()) so the glyph workers
+ * never share or lock it. Bitmaps are kept by area and bits per
+ * pixel: once a glyph of a given size has been processed, the next
+ * one of that size allocates nothing. The run table, the region
+ * and distance maps and the coordinate batch of the path parser are
+ * recalculated in place and keep their memory between glyphs.
+ *
+ * Use ScratchBitmap to hold a bitmap for a scope.
+ *
+ */
+class ScratchPool {
+public:
+
+	/*! \details Returns the pool of the calling thread. */
+	static ScratchPool & get();
+
+	/*! \details Returns an unused bitmap of \a area and \a bits_per_pixel.
+	 *
+	 * The contents are left from the last use.
+	 *
+	 */
+	sgfx::Bitmap & acquire(const sgfx::Area & area, u8 bits_per_pixel);
+
+	/*! \details Returns \a bitmap (from acquire()) to the pool. */
+	void release(sgfx::Bitmap & bitmap);
+
+	/*! \details Returns the thread's run table to recalculate. */
+	RunTable & run_table();
+
+	/*! \details Returns the thread's region map to recalculate. */
+	RegionMap & region_map();
+
+	/*! \details Returns the thread's distance map to recalculate. */
+	DistanceMap & distance_map();
+
+	/*! \details Returns the thread's coordinate batch to refill. */
+	CoordinateBatch & coordinate_batch();
+
+	/*! \details When disabled, every acquire() allocates a new bitmap,
+	 * release() frees it and the maps start empty each time they are
+	 * requested (the behavior before the pool).
+	 *
+	 */
+	void set_enabled(bool value = true);
+	bool is_enabled() const { return m_is_enabled; }
+
+	/*! \details Number of bitmaps and maps that have been allocated. */
+	u32 allocation_count() const { return m_allocation_count; }
+	u32 acquire_count() const { return m_acquire_count; }
+	void reset_counts(){
+		m_allocation_count = 0;
+		m_acquire_count = 0;
+	}
+
+private:
+	ScratchPool();
+
+	typedef struct {
+		std::unique_ptr<sgfx::Bitmap> bitmap;
+		bool is_in_use;
+	} entry_t;
+
+	std::vector<entry_t> m_entries;
+	RunTable m_run_table;
+	RegionMap m_region_map;
+	DistanceMap m_distance_map;
+	CoordinateBatch m_coordinate_batch;
+	bool m_is_enabled;
+	u32 m_allocation_count;
+	u32 m_acquire_count;
+};
+
+/*! \details Holds a bitmap from the calling thread's ScratchPool.
+ *
+ * ```
+ * ScratchBitmap scratch(bitmap.area(), 1);
+ * scratch.bitmap().clear();
+ * ```
+ *
+ */
+class ScratchBitmap {
+public:
+	ScratchBitmap(const sgfx::Area & area, u8 bits_per_pixel) :
+		m_bitmap(ScratchPool::get().acquire(area, bits_per_pixel)){}
+
+	~ScratchBitmap(){
+		ScratchPool::get().release(m_bitmap);
+	}
+
+	sgfx::Bitmap & bitmap(){ return m_bitmap; }
+
+private:
+	ScratchBitmap(const ScratchBitmap &);
+	ScratchBitmap & operator = (const ScratchBitmap &);
+
+	sgfx::Bitmap & m_bitmap;
+};
+
+#endif /* SCRATCHPOOL_HPP_ */
@@ -2,6 +2,14 @@
 
 
 #include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#if defined _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#endif
 #include <sapi/fmt.hpp>
 #include <sapi/var.hpp>
 #include <sapi/sys.hpp>
@@ -9,6 +17,8 @@
 #include <sapi/hal.hpp>
 #include <sapi/sgfx.hpp>
 #include "SvgFontManager.hpp"
+#include "Util.hpp"
+#include "WorkerPool.hpp"
 
 
 SvgFontManager::SvgFontManager() {
@@ -17,6 +27,15 @@ SvgFontManager::SvgFontManager() {
 	m_is_show_canvas = true;
 	m_bmp_font_generator.set_is_ascii();
 	m_scale_sign_y = -1;
+	m_jobs = 1;
+	m_fill = FILL_POUR;
+	m_fill_rule = ScanlineRasterizer::FILL_RULE_NONZERO;
+	m_pour_select = POUR_SELECT_DISTANCE;
+	m_is_multires = false;
+	m_is_pour_grid_auto = false;
+	m_pour_grid_size = POUR_GRID_DEFAULT;
+	m_flatness = 0.0f;
+	m_pour_test = POUR_TEST_RASTER;
 }
 
 int SvgFontManager::process_icons(
@@ -26,6 +45,10 @@ int SvgFontManager::process_icons(
 
 
 	printer().open_object("svg.icons");
+	if( m_fill != FILL_POUR ){
+		printer().warning("icons are stored as vector paths -- using pour points to fill");
+	}
+
 	Vector<String> input_files;
 	String output_file_path;
 	{
@@ -60,20 +83,22 @@ int SvgFontManager::process_icons(
 		}
 	}
 
+	//the collection replaces the output only once it is complete
 	Svic vector_collection;
+	const String temporary_file_path = output_file_path + ".tmp";
 
 	printer().debug(
 				"create svic output file %s",
-				output_file_path.cstring()
+				temporary_file_path.cstring()
 				);
 
 	if( vector_collection.create(
-			 output_file_path,
+			 temporary_file_path,
 			 File::IsOverwrite(true)
 			 ) < 0 ){
 		printer().error(
 					"Failed to create output file %s",
-					output_file_path.cstring()
+					temporary_file_path.cstring()
 					);
 		printer().close_object();
 		return -1;
@@ -83,141 +108,338 @@ int SvgFontManager::process_icons(
 	sg_vector_icon_header_t header;
 	memset(&header, 0, sizeof(header));
 
-	for(auto const & input_file: input_files){
+	m_failures = var::Vector<item_failure_t>();
+	WorkerPool pool(m_jobs);
+	var::Vector<icon_result_t> icon_results;
+	icon_results.resize(input_files.count());
+
+	//icons are converted on the pool and appended in directory order
+	int result = pool.run(
+				input_files.count(),
+				[&](u32 i){
+		//the settings are shared -- the bounds and scale of each icon are kept in its result
+		convert_icon(input_files.at(i), icon_results.at(i));
+	},
+	[&](u32 i){
+		icon_result_t & icon = icon_results.at(i);
 		printer().message(
 					"process input file %s",
-					input_file.cstring()
+					input_files.at(i).cstring()
 					);
 
+		//a bad icon is left out and the rest of the folder is converted
+		if( (icon.status == ITEM_STATUS_OK) && (icon.elements.count() > 0) ){
+			printer().message(
+						"add %s to vector collection (%d objects)",
+						icon.name.cstring(),
+						icon.elements.count()
+						);
 
-		JsonDocument json_document;
-		JsonObject top = json_document.load(
-					JsonDocument::XmlFilePath(
-						input_file
-						)
-					).to_object();
-
-		if( m_is_output_json ){
-			String json_output_path = FileInfo::no_suffix(input_file) + ".json";
-
-			if( Reference( JsonDocument().stringify(top) ).save(
-						json_output_path,
-						Reference::IsOverwrite(true)
-						) < 0 ){
-				printer().error("Failed to save JSON version of file at " +
-									 json_output_path
-									 );
-				return -1;
-			} else {
-				printer().info("JSON of SVG saved to " + json_output_path);
+			if( vector_collection.append(
+					 icon.name,
+					 icon.elements
+					 ) < 0 ){
+				printer().error("Failed to add %s to vector collection", icon.name.cstring());
+				icon.status = ITEM_STATUS_APPEND_FAILED;
 			}
 		}
 
-		JsonObject svg_icon = top.at("svg").to_object();
+		//the status and name are kept for the summary
+		icon.elements = var::Vector<sg_vector_path_description_t>();
+		return true;
+	});
 
-		if( !svg_icon.is_valid() || svg_icon.is_empty() ){
-			printer().error(
-						"failed to find svg icon in %s",
-						source_path.argument().cstring()
-						);
-			printer().close_object();
-			return -1;
+	//workers copy this object so failures are only added once they are done
+	for(u32 i=0; i < icon_results.count(); i++){
+		const icon_result_t & icon = icon_results.at(i);
+		if( icon.status == ITEM_STATUS_OK ){
+			continue;
 		}
 
+		add_failure(
+					icon.name.is_empty() ? FileInfo::base_name(input_files.at(i)) : icon.name,
+					input_files.at(i),
+					icon.status
+					);
+		if( m_quarantine_path.is_empty() == false ){
+			quarantine_icon(input_files.at(i));
+		}
+	}
 
-		process_svg_icon(svg_icon);
+	printer().message("closing collection file");
+	vector_collection.close();
 
-		if( m_vector_path_icon_list.count() > 0 ){
-			printer().message("get name of icon from @data-icon");
-			String name =
-					svg_icon.at("@data-icon").to_string();
+	if( (result < 0) ||
+		 (replace_file(temporary_file_path, output_file_path) < 0) ){
+		printer().error(
+					"Failed to write output file %s",
+					output_file_path.cstring()
+					);
+		File::remove(temporary_file_path);
+		printer().close_object();
+		return -1;
+	}
 
-			if( name.is_empty() ){
-				name = FileInfo::base_name(input_file);
-			}
+	print_summary(input_files.count() - m_failures.count());
+	printer().close_object();
 
-			printer().message(
-						"add %s to vector collection (%d objects)",
-						name.cstring(),
-						m_vector_path_icon_list.count()
-						);
+	return 0;
+}
 
-			if( vector_collection.append(
-					 name,
-					 m_vector_path_icon_list
-					 ) < 0 ){
-				printer().error("Failed to add %s to vector collection", name.cstring());
+const char * SvgFontManager::get_item_status_name(enum item_status value){
+	switch(value){
+		case ITEM_STATUS_OK: return "ok";
+		case ITEM_STATUS_INVALID: return "invalid";
+		case ITEM_STATUS_MISSING_PATH: return "missing path";
+		case ITEM_STATUS_PARSE_FAILED: return "parse failed";
+		case ITEM_STATUS_OUT_OF_RANGE: return "out of range";
+		case ITEM_STATUS_APPEND_FAILED: return "append failed";
+	}
+	return "unknown";
+}
+
+void SvgFontManager::add_failure(
+		const String & name,
+		const String & source,
+		enum item_status status
+		){
+	item_failure_t failure;
+	failure.name = name;
+	failure.source = source;
+	failure.status = status;
+	printer().warning(
+				"skipping %s (%s)",
+				name.cstring(),
+				get_item_status_name(status)
+				);
+	m_failures.push_back(failure);
+}
+
+int SvgFontManager::quarantine_icon(const String & source){
+	String destination = m_quarantine_path + "/" + FileInfo::name(source);
+	if( replace_file(source, destination) < 0 ){
+		return -1;
+	}
+	printer().message(
+				"moved %s to %s",
+				source.cstring(),
+				destination.cstring()
+				);
+	return 0;
+}
+
+void SvgFontManager::print_summary(u32 converted_count){
+	printer().open_object("summary");
+	printer().key("converted", "%ld", converted_count);
+	printer().key("failed", "%ld", m_failures.count());
+	if( m_failures.count() > 0 ){
+		printer().open_object("failures");
+		for(const auto & failure: m_failures){
+			String value = get_item_status_name(failure.status);
+			if( failure.source.is_empty() == false ){
+				value << " " << failure.source;
 			}
+			printer().key(failure.name, value);
 		}
+		printer().close_object();
 	}
-
-	printer().message("closing collection file");
-	vector_collection.close();
 	printer().close_object();
+}
+
+int SvgFontManager::replace_file(const String & source, const String & destination){
+#if defined _WIN32
+	//rename() does not replace an existing file on windows
+	if( MoveFileExA(
+				source.cstring(),
+				destination.cstring(),
+				MOVEFILE_REPLACE_EXISTING
+				) == 0 ){
+		printer().error(
+					"Failed to rename %s to %s (error %ld)",
+					source.cstring(),
+					destination.cstring(),
+					(long)GetLastError()
+					);
+		return -1;
+	}
+#else
+	//the destination is left as is if it can't be replaced
+	if( ::rename(source.cstring(), destination.cstring()) < 0 ){
+		printer().error(
+					"Failed to rename %s to %s (%s)",
+					source.cstring(),
+					destination.cstring(),
+					strerror(errno)
+					);
+		return -1;
+	}
+#endif
+	return 0;
+}
+
+int SvgFontManager::convert_icon(
+		const String & input_file,
+		icon_result_t & icon
+		){
+	String view_box;
+	var::Vector<String> drawing_paths;
+
+	icon.elements = var::Vector<sg_vector_path_description_t>();
+	icon.status = ITEM_STATUS_OK;
+
+	if( m_is_output_json && (save_json(input_file) < 0) ){
+		icon.status = ITEM_STATUS_INVALID;
+		return -1;
+	}
+
+	if( read_svg_icon(
+			 input_file,
+			 icon.name,
+			 view_box,
+			 drawing_paths
+			 ) < 0 ){
+		icon.status = ITEM_STATUS_INVALID;
+		return -1;
+	}
+
+	if( process_svg_icon(view_box, drawing_paths, icon) < 0 ){
+		return -1;
+	}
+
+	if( icon.name.is_empty() ){
+		icon.name = FileInfo::base_name(input_file);
+	}
 
 	return 0;
 }
 
-int SvgFontManager::process_svg_icon(
-		const JsonObject & object
+int SvgFontManager::read_svg_icon(
+		const String & input_file,
+		String & name,
+		String & view_box,
+		var::Vector<String> & drawing_paths
 		){
+	SvgReader reader;
+	SvgReader::Element element;
+	bool is_svg_found = false;
+	int path_count = 0;
 
-	printer().open_object("svg.convert");
-	printer().open_object("json", sys::Printer::DEBUG);
-	{
-		printer() << object;
-		printer().close_object();
+	if( reader.open(input_file) < 0 ){
+		return -1;
+	}
+
+	while( reader.next(element) ){
+		if( element.is_closing() ){
+			continue;
+		}
+
+		if( element.is_name("svg") && (is_svg_found == false) ){
+			is_svg_found = true;
+			view_box = element.attribute("viewBox");
+			name = element.attribute("data-icon");
+		} else if( element.is_name("path") ){
+			drawing_paths.push_back(element.attribute("d"));
+			path_count++;
+		}
+	}
+
+	if( is_svg_found == false ){
+		printer().error(
+					"failed to find svg icon in %s",
+					input_file.cstring()
+					);
+		return -1;
+	}
+
+	return path_count;
+}
+
+int SvgFontManager::save_json(const String & input_file){
+	JsonObject object =
+			JsonDocument().load(
+				JsonDocument::XmlFilePath(input_file)
+				).to_object();
+
+	String json_output_path = FileInfo::no_suffix(input_file) + ".json";
+
+	if( Reference( JsonDocument().stringify(object) ).save(
+				json_output_path,
+				Reference::IsOverwrite(true)
+				) < 0 ){
+		printer().error("Failed to save JSON version of file at " +
+							 json_output_path
+							 );
+		return -1;
 	}
 
-	String view_box
-			= object.at("@viewBox").to_string();
+	printer().info("JSON of SVG saved to " + json_output_path);
+	return 0;
+}
+
+int SvgFontManager::process_svg_icon(
+		const String & view_box,
+		const var::Vector<String> & drawing_paths,
+		icon_result_t & icon
+		){
+
+	printer().open_object("svg.convert");
 
 	printer().message(
 				"viewBox %s",
 				view_box.cstring()
 				);
 
+	const Area canvas_dimensions(m_canvas_size, m_canvas_size);
 	if( view_box.is_empty() == false ){
-		m_bounds = parse_bounds(view_box.cstring());
-		m_aspect_ratio = m_bounds.width() * 1.0f / m_bounds.height();
-		//m_aspect_ratio = 1.0f;
-		m_canvas_dimensions = Area(m_canvas_size, m_canvas_size);
-		printer().open_object("bounds") << m_bounds;
+		icon.bounds = parse_bounds(view_box.cstring());
+		icon.aspect_ratio = icon.bounds.width() * 1.0f / icon.bounds.height();
+		printer().open_object("bounds") << icon.bounds;
 		printer().close_object();
-		printer().open_object("Canvas Dimensions") << m_canvas_dimensions;
+		printer().open_object("Canvas Dimensions") << canvas_dimensions;
 		printer().close_object();
 	} else {
 		printer().warning("Failed to find bounding box");
+		icon.status = ITEM_STATUS_INVALID;
 		printer().close_object();
 		return -1;
 	}
 
-	m_scale = ( SG_MAP_MAX * 1.0f ) / (m_bounds.area().maximum_dimension());
-	printer().message("Scaling factor is %0.2f", m_scale);
-
-	//d is the path
+	icon.scale = ( SG_MAP_MAX * 1.0f ) / (icon.bounds.area().maximum_dimension());
+	printer().message("Scaling factor is %0.2f", icon.scale);
 
-	JsonObject path = object.at("path").to_object();
-	if( path.is_empty() ){
-		printer().error("path not found for icon");
-		return -1;
+	//each path is parsed on its own (so it starts from the origin) and
+	//drawn as sub-paths of one path
+	var::Vector<sg_vector_path_description_t> elements;
+	for(const auto & d: drawing_paths){
+		var::Vector<sg_vector_path_description_t> path_elements =
+				process_svg_path(d.cstring(), d.length(), icon.scale, &icon.status);
+		if( icon.status != ITEM_STATUS_OK ){
+			printer().close_object();
+			return -1;
+		}
+		for(const auto & element: path_elements){
+			elements.push_back(element);
+		}
 	}
 
-	String drawing_path;
-	drawing_path = path.at("@d").to_string();
-	if( drawing_path.is_empty() ){
+	if( elements.count() == 0 ){
 		printer().error("drawing path not found for icon");
+		icon.status = ITEM_STATUS_MISSING_PATH;
+		printer().close_object();
 		return -1;
 	}
 
 	Bitmap canvas;
-	m_vector_path_icon_list
+	Point canvas_offset;
+	icon.elements
 			= convert_svg_path(
 				canvas,
-				drawing_path,
-				m_canvas_dimensions,
+				elements,
+				canvas_dimensions,
 				m_pour_grid_size,
-				true
+				true,
+				canvas_offset,
+				icon.aspect_ratio
 				);
 
 	printer().open_object("canvas size") << canvas.area();
@@ -241,36 +463,72 @@ int SvgFontManager::process_font(
 		fs::File::SourcePath source_file_path,
 		fs::File::DestinationPath destination_directory_path
 		){
-	u32 j;
 
-	JsonDocument json_document;
+	ClockTimer timer;
+	timer.start();
 
-	//some docs start as an array
-	JsonObject font_object =
-			json_document.load(
-				JsonDocument::XmlFilePath(source_file_path.argument())
-				).to_object();
-
-	if( m_is_output_json ){
-		String json_output_path = FileInfo::no_suffix(source_file_path.argument()) + ".json";
+	if( m_is_output_json && (save_json(source_file_path.argument()) < 0) ){
+		return -1;
+	}
 
-		if( Reference( JsonDocument().stringify(font_object) ).save(
-					json_output_path,
-					Reference::IsOverwrite(true)
-					) < 0 ){
-			printer().error("Failed to save JSON version of file at " +
-								 json_output_path
-								 );
-			return -1;
-		} else {
-			printer().info("JSON of SVG saved to " + json_output_path);
-		}
+	//glyphs and kerning pairs are streamed rather than loaded as a document
+	SvgReader reader;
+	if( reader.open(source_file_path.argument()) < 0 ){
+		return -1;
 	}
 
+	SvgReader::Element element;
+	bool is_svg_found = false;
+	bool is_font_face_found = false;
+	m_glyph_jobs = var::Vector<glyph_job_t>();
+	m_character_set_code_points.clear();
+	m_character_set_code_points.insert(character_set());
+	m_loaded_code_points.clear();
+	m_failed_code_points.clear();
+	m_failures = var::Vector<item_failure_t>();
+	u32 glyph_count = 0;
+	u32 hkern_count = 0;
+
+	while( reader.next(element) ){
+		if( element.is_closing() ){
+			continue;
+		}
 
-	JsonObject svg_object = font_object.at("svg").to_object();
+		if( element.is_name("svg") ){
+			is_svg_found = true;
+			printer().open_object("svg.convert");
+		} else if( is_svg_found == false ){
+			continue;
+		} else if( element.is_name("metadata") ){
+			printer().key("metadata", reader.read_text());
+		} else if( element.is_name("font") ){
+			printer().key("font", element.attribute("id"));
+		} else if( element.is_name("font-face") ){
+			if( process_font_face(element) < 0 ){
+				printer().close_object();
+				return -1;
+			}
+			is_font_face_found = true;
+		} else if( element.is_name("glyph") ){
+			if( is_font_face_found == false ){
+				printer().error("glyph found before font-face");
+				printer().close_object();
+				return -1;
+			}
+			glyph_count++;
+			process_glyph(element);
+		} else if( element.is_name("hkern") ){
+			if( is_font_face_found == false ){
+				printer().error("hkern found before font-face");
+				printer().close_object();
+				return -1;
+			}
+			hkern_count++;
+			process_hkern(element);
+		}
+	}
 
-	if( svg_object.is_empty() ){
+	if( is_svg_found == false ){
 		printer().debug(
 					"loaded svg file %s",
 					source_file_path.argument().cstring()
@@ -279,75 +537,53 @@ int SvgFontManager::process_font(
 		return -1;
 	}
 
-	printer().open_object("svg.convert");
-
-	String metadata = svg_object.at("metadata").to_string();
-	JsonObject defs = svg_object.at("defs").to_object();
-	JsonObject font = defs.at("font").to_object();
-	JsonArray glyphs = font.at("glyph").to_array();
-	JsonArray hkerns = font.at("hkern").to_array();
-	JsonObject font_face = font.at("font-face").to_object();
-	JsonObject missing_glyph = font.at("missing-glyph").to_object();
-
-	printer().key("metadata", metadata);
-	printer().key("font", font.at("@id").to_string());
-	printer().key("fontFamily", font_face.at("@font-family").to_string());
-	printer().key("fontStretch", font_face.at("@font-stretch").to_string());
-	u16 units_per_em = font_face.at("@units-per-em").to_string().to_integer();
-
-	printer().key("unitsPerEm", "%d", units_per_em);
-
-	m_scale = (SG_MAP_MAX*1.0f) / (units_per_em);
-
-	String value;
-	value = font_face.at("@bbox").to_string();
-	printer().message(
-				"bbox: %s",
-				value.cstring()
-				);
-
-	if( value.is_empty() ){
-		printer().warning("Failed to find bounding box");
+	if( is_font_face_found == false ){
+		printer().warning("Failed to find font-face");
+		printer().close_object();
 		return -1;
 	}
 
-	m_bounds = parse_bounds(value.cstring());
-	m_canvas_dimensions = calculate_canvas_dimension(m_bounds, m_canvas_size);
-	m_canvas_origin = calculate_canvas_origin(m_bounds, m_canvas_dimensions);
-	printer().open_object("SVG bounds") << m_bounds;
-	printer().close_object();
-
-	m_point_size =
-			1.0f * m_canvas_dimensions.height() * units_per_em / m_bounds.area().height() * SG_MAP_MAX / (SG_MAX);
-
-	printer().message("Glyph count %ld", glyphs.count());
+	if( m_glyph_jobs.count() > 0 ){
+		WorkerPool pool(m_jobs);
+		var::Vector<glyph_result_t> glyph_results;
+		glyph_results.resize(m_glyph_jobs.count());
 
-
-	printer().key(
-				"characterSet", character_set().is_empty() ?
-					"<all>" :
-					character_set().cstring()
+		printer().message(
+					"rasterize %ld glyphs with %ld jobs",
+					m_glyph_jobs.count(),
+					pool.jobs()
 					);
 
-	for(j=0; j < glyphs.count();j++){
-		//d is the path
-		JsonObject glyph = glyphs.at(j).to_object();
-		printer().open_object("glyph", Printer::level_debug);
-		printer() << glyph;
-		printer().close_object();
-		process_glyph(glyph);
-	}
+		//commits happen in file order so the output matches a serial run
+		pool.run(
+					m_glyph_jobs.count(),
+					[&](u32 i){
+			const glyph_job_t & job = m_glyph_jobs.at(i);
+			rasterize_glyph(
+						job,
+						job.drawing_path.cstring(),
+						job.drawing_path.length(),
+						glyph_results.at(i)
+						);
+		},
+		[&](u32 i){
+			const glyph_job_t & job = m_glyph_jobs.at(i);
+			if( glyph_results.at(i).status == ITEM_STATUS_OK ){
+				commit_glyph(job, glyph_results.at(i));
+			} else {
+				m_failed_code_points.insert(job.ascii_value);
+				add_failure(job.name, String(), glyph_results.at(i).status);
+			}
+			//release the bitmaps as soon as they are copied to the generator
+			glyph_results.at(i) = glyph_result_t();
+			return true;
+		});
 
-	for(j=0; j < hkerns.count();j++){
-		//d is the path
-		JsonObject hkern = hkerns.at(j).to_object();
-		printer().open_object("hkern", Printer::level_debug);
-		printer() << hkern;
-		printer().close_object();
-		process_hkern(hkern);
+		m_glyph_jobs = var::Vector<glyph_job_t>();
 	}
 
-
+	printer().message("Glyph count %ld", glyph_count);
+	printer().message("Kerning count %ld", hkern_count);
 
 	String output_name =
 			destination_directory_path.argument() + "/" +
@@ -357,6 +593,8 @@ int SvgFontManager::process_font(
 			<< String().format("-%d", m_point_size / m_downsample.height());
 
 	m_bmp_font_generator.set_bits_per_pixel(bits_per_pixel());
+	m_bmp_font_generator.set_packer(packer());
+	m_bmp_font_generator.set_canvas_budget(canvas_budget());
 	m_bmp_font_generator.set_generate_map( is_generate_map() );
 	if( is_generate_map() ){
 		String map_file;
@@ -364,56 +602,112 @@ int SvgFontManager::process_font(
 		m_bmp_font_generator.set_map_output_file(map_file);
 	}
 
-	//check for missing characters
+	//check for missing characters (a glyph that failed is missing)
 	bool is_missing = false;
 	for(const auto c: character_set()){
-		bool is_found = false;
-		for(const auto & from_list: m_bmp_font_generator.character_list()){
-			if( c == from_list.id ){
-				is_found = true;
-				break;
-			}
-		}
-
-		if( is_found == false ){
+		if( (m_loaded_code_points.contains((u8)c) == false) ||
+			 m_failed_code_points.contains((u8)c) ){
 			is_missing = true;
 			printer().error("Required character %c not found", c);
 		}
 	}
 
+	print_summary(m_loaded_code_points.count() - m_failed_code_points.count());
+
 	if( is_missing ){
+		printer().close_object();
 		return -1;
 	}
 
 	m_bmp_font_generator.generate_font_file(output_name);
 	printer().message("Created %s", output_name.cstring());
+
+	timer.stop();
+	printer().open_object("statistics");
+	{
+		printer().key("time", "%ldms", timer.milliseconds());
+		if( reader.is_mapped() ){
+			printer().key("readBuffer", "mapped");
+		} else {
+			printer().key("readBuffer", "%ld", reader.buffer_size());
+		}
+		printer().key("peakMemory", "%ldKB", Util::get_peak_memory_usage() / 1024);
+		printer().close_object();
+	}
+
+	printer().close_object();
+	return 0;
+}
+
+int SvgFontManager::process_font_face(const SvgReader::Element & font_face){
+
+	printer().key("fontFamily", font_face.attribute("font-family"));
+	printer().key("fontStretch", font_face.attribute("font-stretch"));
+	u16 units_per_em = font_face.attribute("units-per-em").to_integer();
+
+	printer().key("unitsPerEm", "%d", units_per_em);
+
+	if( units_per_em == 0 ){
+		printer().warning("Failed to find units per em");
+		return -1;
+	}
+
+	m_scale = (SG_MAP_MAX*1.0f) / (units_per_em);
+
+	String value;
+	value = font_face.attribute("bbox");
+	printer().message(
+				"bbox: %s",
+				value.cstring()
+				);
+
+	if( value.is_empty() ){
+		printer().warning("Failed to find bounding box");
+		return -1;
+	}
+
+	m_bounds = parse_bounds(value.cstring());
+	m_canvas_dimensions = calculate_canvas_dimension(m_bounds, m_canvas_size);
+	m_canvas_origin = calculate_canvas_origin(m_bounds, m_canvas_dimensions);
+	printer().open_object("SVG bounds") << m_bounds;
+	printer().close_object();
+
+	m_point_size =
+			1.0f * m_canvas_dimensions.height() * units_per_em / m_bounds.area().height() * SG_MAP_MAX / (SG_MAX);
+
+	printer().key(
+				"characterSet", character_set().is_empty() ?
+					"<all>" :
+					character_set().cstring()
+					);
+
 	return 0;
 }
 
-int SvgFontManager::process_hkern(const JsonObject & kerning){
+int SvgFontManager::process_hkern(const SvgReader::Element & kerning){
 
-	if( kerning.is_object() ){
+	if( kerning.is_name("hkern") ){
 		char first;
 		char second;
 
 		String first_string;
 		String second_string;
 
-		first_string = kerning.at("@u1").to_string();
+		first_string = kerning.attribute("u1");
 		if( first_string.is_empty() || first_string.length() != 1 ){
 			return 0;
 		}
 
-		if( character_set().find(first_string) == String::npos ){
+		if( m_character_set_code_points.contains((u8)first_string.at(0)) == false ){
 			return 0;
 		}
 
-		second_string = kerning.at("@u2").to_string();
+		second_string = kerning.attribute("u2");
 		if( second_string.is_empty() || second_string.length() != 1 ){
 			return 0;
 		}
 
-		if( character_set().find(second_string) == String::npos ){
+		if( m_character_set_code_points.contains((u8)second_string.at(0)) == false ){
 			return 0;
 		}
 
@@ -428,7 +722,7 @@ int SvgFontManager::process_hkern(const JsonObject & kerning){
 		kerning_pair.unicode_first = first;
 		kerning_pair.unicode_second = second;
 
-		s16 specified_kerning = kerning.at("@k").to_integer();
+		s16 specified_kerning = kerning.attribute("k").to_integer();
 		int kerning_sign;
 		if( specified_kerning < 0 ){
 			kerning_sign = -1;
@@ -486,50 +780,79 @@ sg_size_t SvgFontManager::map_svg_value_to_bitmap(u32 value){
 	return point.x();
 }
 
-int SvgFontManager::process_glyph(const JsonObject & glyph){
+int SvgFontManager::process_glyph(const SvgReader::Element & glyph){
+	glyph_job_t job;
+	int result = load_glyph_job(glyph, job);
+	if( result <= 0 ){
+		return result;
+	}
+
+	if( m_jobs > 1 ){
+		//rasterized on the worker pool once the whole file is read
+		job.drawing_path = glyph.attribute("d");
+		m_glyph_jobs.push_back(job);
+		return 0;
+	}
+
+	//the path is used in place -- it is never copied out of the reader
+	const char * drawing_path;
+	u32 drawing_path_length;
+	glyph.find_attribute("d", drawing_path, drawing_path_length);
+
+	glyph_result_t glyph_result;
+	if( rasterize_glyph(job, drawing_path, drawing_path_length, glyph_result) < 0 ){
+		m_failed_code_points.insert(job.ascii_value);
+		add_failure(job.name, String(), glyph_result.status);
+		return -1;
+	}
+	commit_glyph(job, glyph_result);
+	return 0;
+}
+
+int SvgFontManager::load_glyph_job(const SvgReader::Element & glyph, glyph_job_t & job){
 
-	String glyph_name = glyph.at("@glyph-name").to_string();
-	String unicode = glyph.at("@unicode").to_string();
+	String glyph_name = glyph.attribute("glyph-name");
+	String unicode = glyph.attribute("unicode");
 	u8 ascii_value = ' ';
 
 	bool is_in_character_set = false;
 	if( !character_set().is_empty() ){
 		if( unicode.length() == 1 ){
 			ascii_value = unicode.at(0);
-			if( character_set().find(ascii_value) != String::npos ){
+			if( m_character_set_code_points.contains(ascii_value) ){
 				is_in_character_set = true;
 			}
 		} else {
 			if( glyph_name == "ampersand" ){
-				if( character_set().find("&") != String::npos ){
+				if( m_character_set_code_points.contains('&') ){
 					ascii_value = '&';
 					is_in_character_set = true;
 				}
 			}
 
 			if( glyph_name == "quotedbl" ){
-				if( character_set().find("\"") != String::npos ){
+				if( m_character_set_code_points.contains('"') ){
 					ascii_value = '"';
 					is_in_character_set = true;
 				}
 			}
 
 			if( glyph_name == "quotesinglbase"  ){
-				if( character_set().find("'") != String::npos ){
+				if( m_character_set_code_points.contains('\'') ){
 					ascii_value = '\'';
 					is_in_character_set = true;
 				}
 			}
 
 			if( glyph_name == "less" ){
-				if( character_set().find("\"") != String::npos ){
+				if( m_character_set_code_points.contains('"') ){
 					ascii_value = '<';
 					is_in_character_set = true;
 				}
 			}
 
 			if( glyph_name == "greater" ){
-				if( character_set().find("\"") != String::npos ){
+				if( m_character_set_code_points.contains('"') ){
 					ascii_value = '>';
 					is_in_character_set = true;
 				}
@@ -539,41 +862,101 @@ int SvgFontManager::process_glyph(const JsonObject & glyph){
 		is_in_character_set = true;
 	}
 
-	if( is_in_character_set ){
-
-		for(const auto & entry: m_bmp_font_generator.character_list()){
-			if( entry.id == ascii_value ){
-				return 0;
-			}
-		}
+	if( is_in_character_set == false ){
+		return 0;
+	}
 
-		if( !glyph_name.is_empty() ){
-			printer().message("Glyph Name: %s", glyph_name.cstring());
-			printer().message("Unicode is %s", unicode.cstring());
-		} else {
-			printer().error("Glyph name not found");
-			return -1;
-		}
+	//glyphs that are queued for the worker pool count as loaded
+	if( m_loaded_code_points.contains(ascii_value) ){
+		return 0;
+	}
 
-		String x_advance = glyph.at("@horiz-adv-x").to_string();
+	if( !glyph_name.is_empty() ){
+		printer().message("Glyph Name: %s", glyph_name.cstring());
+		printer().message("Unicode is %s", unicode.cstring());
+	} else {
+		printer().error("Glyph name not found");
+		add_failure(unicode, String(), ITEM_STATUS_INVALID);
+		return -1;
+	}
 
-		String drawing_path;
-		drawing_path = glyph.at("@d").to_string();
-		if( drawing_path.is_empty() ){
-			printer().error("drawing path not found");
+	const char * drawing_path;
+	u32 drawing_path_length;
+	if( glyph.find_attribute("d", drawing_path, drawing_path_length) == false ||
+		 drawing_path_length == 0 ){
+		printer().error("drawing path not found");
+		add_failure(glyph_name, String(), ITEM_STATUS_MISSING_PATH);
+		return -1;
+	}
+
+	m_loaded_code_points.insert(ascii_value);
+	job.ascii_value = ascii_value;
+	job.name = glyph_name;
+	job.x_advance = glyph.attribute("horiz-adv-x").to_integer();
+	job.unicode = unicode;
+	return 1;
+}
+
+int SvgFontManager::rasterize_glyph(
+		const glyph_job_t & job,
+		const char * d,
+		u32 d_length,
+		glyph_result_t & result
+		){
+
+	//only reads the font settings so glyphs can be rasterized concurrently
+	result.status = ITEM_STATUS_OK;
+	Region active_region;
+	Bitmap active_canvas;
+	Bitmap active_canvas_downsampled;
+	active_canvas.set_bits_per_pixel(bits_per_pixel());
+	active_canvas_downsampled.set_bits_per_pixel(bits_per_pixel());
+
+	if( m_fill == FILL_COVERAGE ){
+		//no full size canvas -- coverage is sampled on the downsampled grid
+		var::Vector<sg_vector_path_description_t> elements =
+				process_svg_path(d, d_length, &result.status);
+		if( result.status != ITEM_STATUS_OK ){
 			return -1;
 		}
 
+		PathGeometry geometry;
+		flatten_path(
+					geometry,
+					elements,
+					Region(Point(0,0), m_canvas_dimensions)
+					);
+		active_region = geometry.calculate_pixel_bounds();
+
+		Area downsampled;
+		downsampled.set_width( (active_region.area().width() + m_downsample.width()/2) / m_downsample.width() );
+		downsampled.set_height( (active_region.area().height() + m_downsample.height()/2) / m_downsample.height() );
+		active_canvas_downsampled.allocate(downsampled);
+		active_canvas_downsampled.clear();
+		ScanlineRasterizer(geometry, m_fill_rule)
+				.fill_coverage(
+					active_canvas_downsampled,
+					active_region.point(),
+					m_downsample
+					);
+	} else {
 		Bitmap canvas;
+		Point canvas_offset;
 		canvas.set_bits_per_pixel(bits_per_pixel());
 
-		m_vector_path_icon_list = convert_svg_path(
+		convert_svg_path(
 					canvas,
-					drawing_path,
+					d,
+					d_length,
 					m_canvas_dimensions,
 					m_pour_grid_size,
-					false
+					false,
+					canvas_offset,
+					&result.status
 					);
+		if( result.status != ITEM_STATUS_OK ){
+			return -1;
+		}
 
 #if 0
 		printer().open_object("origin") << m_canvas_origin;
@@ -582,18 +965,14 @@ int SvgFontManager::process_glyph(const JsonObject & glyph){
 		canvas.draw_line(Point(0, m_canvas_origin.y()), Point(canvas.x_max(), m_canvas_origin.y()));
 
 		if( m_is_show_canvas ){
-			printer().open_object(String().format("character-%s", unicode.cstring()));
+			printer().open_object(String().format("character-%s", job.unicode.cstring()));
 			printer() << canvas;
 			printer().close_object();
 		}
 #endif
 
-
-		Region active_region = canvas.calculate_active_region();
-		Bitmap active_canvas(
-					active_region.area(),
-					Bitmap::BitsPerPixel(bits_per_pixel())
-					);
+		active_region = canvas.calculate_active_region();
+		active_canvas.allocate(active_region.area());
 
 		active_canvas.draw_sub_bitmap(
 					sg_point(0,0),
@@ -601,13 +980,16 @@ int SvgFontManager::process_glyph(const JsonObject & glyph){
 					active_region
 					);
 
+		//offsets are relative to the full canvas
+		active_region << Point(
+								  active_region.point().x() + canvas_offset.x(),
+								  active_region.point().y() + canvas_offset.y()
+								  );
+
 		Area downsampled;
 		downsampled.set_width( (active_canvas.width() + m_downsample.width()/2) / m_downsample.width() );
 		downsampled.set_height( (active_canvas.height() + m_downsample.height()/2) / m_downsample.height() );
-		Bitmap active_canvas_downsampled(
-					downsampled,
-					Bitmap::BitsPerPixel(bits_per_pixel())
-					);
+		active_canvas_downsampled.allocate(downsampled);
 
 		active_canvas_downsampled.clear();
 		active_canvas_downsampled
@@ -615,74 +997,111 @@ int SvgFontManager::process_glyph(const JsonObject & glyph){
 					active_canvas,
 					m_downsample
 					);
+	}
+
+	//find region inhabited by character
 
-		//find region inhabited by character
+	sg_font_char_t & character = result.character;
 
-		sg_font_char_t character;
+	character.id = job.ascii_value; //unicode value
+	character.advance_x = (map_svg_value_to_bitmap( job.x_advance ) + m_downsample.width()/2) / m_downsample.width(); //value from SVG file -- needs to translate to bitmap
 
-		character.id = ascii_value; //unicode value
-		character.advance_x = (map_svg_value_to_bitmap( x_advance.to_integer() ) + m_downsample.width()/2) / m_downsample.width(); //value from SVG file -- needs to translate to bitmap
+	//derive width, height, offset_x, offset_y from image
+	//for offset_x and offset_y what is the standard?
 
-		//derive width, height, offset_x, offset_y from image
-		//for offset_x and offset_y what is the standard?
+	character.width = active_canvas_downsampled.width(); //width of bitmap
+	character.height = active_canvas_downsampled.height(); //height of the bitmap
+	character.offset_x = (active_region.point().x() - m_canvas_origin.x() + m_downsample.width()/2) / m_downsample.width(); //x offset when drawing the character
+	character.offset_y = (active_region.point().y() - (m_canvas_origin.y() - m_point_size) + m_downsample.height()/2) / m_downsample.height(); //y offset when drawing the character
 
-		character.width = active_canvas_downsampled.width(); //width of bitmap
-		character.height = active_canvas_downsampled.height(); //height of the bitmap
-		character.offset_x = (active_region.point().x() - m_canvas_origin.x() + m_downsample.width()/2) / m_downsample.width(); //x offset when drawing the character
-		printer().message("offset y %d - (%d - %d)", active_region.point().y(), m_canvas_origin.y(), m_point_size);
-		character.offset_y = (active_region.point().y() - (m_canvas_origin.y() - m_point_size) + m_downsample.height()/2) / m_downsample.height(); //y offset when drawing the character
+	//add character to master canvas, canvas_x and canvas_y are location on the master canvas
+	character.canvas_x = 0; //x location on master canvas -- set when font is generated
+	character.canvas_y = 0; //y location on master canvas -- set when font is generated
 
-		//add character to master canvas, canvas_x and canvas_y are location on the master canvas
-		character.canvas_x = 0; //x location on master canvas -- set when font is generated
-		character.canvas_y = 0; //y location on master canvas -- set when font is generated
+	result.active_region = active_region;
+	if( m_is_show_canvas ){
+		result.active_canvas = active_canvas;
+	}
+	result.bitmap = active_canvas_downsampled;
+	return 0;
+}
 
-		m_bmp_font_generator.character_list().push_back(character);
-		m_bmp_font_generator.bitmap_list().push_back(active_canvas_downsampled);
+void SvgFontManager::commit_glyph(
+		const glyph_job_t & job,
+		const glyph_result_t & result
+		){
+	const sg_font_char_t & character = result.character;
+
+	printer().message("offset y %d - (%d - %d)", result.active_region.point().y(), m_canvas_origin.y(), m_point_size);
+
+	m_bmp_font_generator.character_list().push_back(character);
+	m_bmp_font_generator.bitmap_list().push_back(result.bitmap);
 
 #if !SHOW_ORIGIN
-		if( m_is_show_canvas ){
-			printer().open_object(String().format("active character-%s (%c)", unicode.cstring(), ascii_value));
+	if( m_is_show_canvas ){
+		printer().open_object(String().format("active character-%s (%c)", job.unicode.cstring(), job.ascii_value));
+		{
+			printer() << result.active_region;
+			printer() << result.active_canvas;
+			printer() << result.bitmap;
+			printer().open_object("character");
 			{
-				printer() << active_region;
-				printer() << active_canvas;
-				printer() << active_canvas_downsampled;
-				printer().open_object("character");
-				{
-					printer().key("advance x", "%d", character.advance_x);
-					printer().key("offset x", "%d", character.offset_x);
-					printer().key("offset y", "%d", character.offset_y);
-					printer().key("width", "%d", character.width);
-					printer().key("height", "%d", character.height);
-					printer().close_object();
-				}
+				printer().key("advance x", "%d", character.advance_x);
+				printer().key("offset x", "%d", character.offset_x);
+				printer().key("offset y", "%d", character.offset_y);
+				printer().key("width", "%d", character.width);
+				printer().key("height", "%d", character.height);
 				printer().close_object();
 			}
+			printer().close_object();
 		}
+	}
 #endif
-		if( character.id == '"' ){
-			printer().info("-------------Double Quote added-----------\n");
-			//exit(1);
-		}
+	if( character.id == '"' ){
+		printer().info("-------------Double Quote added-----------\n");
+		//exit(1);
+	}
+}
 
+Region SvgFontManager::calculate_canvas_window(
+		const Region & path_region,
+		const Area & canvas_dimensions,
+		sg_size_t grid_size
+		){
+	s32 x = path_region.point().x() - CANVAS_MARGIN;
+	s32 y = path_region.point().y() - CANVAS_MARGIN;
+	if( x < 0 ){ x = 0; }
+	if( y < 0 ){ y = 0; }
+
+	//keep the pour grid rows where they are on the full canvas
+	if( grid_size ){
+		y -= y % grid_size;
 	}
-	return 0;
 
+	s32 right = path_region.point().x() + path_region.area().width() + CANVAS_MARGIN;
+	s32 bottom = path_region.point().y() + path_region.area().height() + CANVAS_MARGIN;
+	if( right > canvas_dimensions.width() ){ right = canvas_dimensions.width(); }
+	if( bottom > canvas_dimensions.height() ){ bottom = canvas_dimensions.height(); }
+
+	return Region(Point(x, y), Area(right - x, bottom - y));
 }
 
 void SvgFontManager::fit_icon_to_canvas(
 		Bitmap & bitmap,
 		VectorPath & vector_path,
-		const VectorMap & map
+		const VectorMap & map,
+		float aspect_ratio
 		){
-	Region active_region
-			= bitmap.calculate_active_region();
+	//the fit is measured on a trial render (see --benchmark=fit for how
+	//it compares with the analytic path bounds)
+	sgfx::Vector::draw(bitmap, vector_path, map);
+	Region active_region = bitmap.calculate_active_region();
 
 	Point map_shift;
 	Point bitmap_shift;
 	float width_scale, height_scale;
 
 	printer().open_object("fit icon to canvas", Printer::MESSAGE);
-	printer() << bitmap;
 
 	printer().open_object("active region");
 	printer() << active_region;
@@ -712,10 +1131,10 @@ void SvgFontManager::fit_icon_to_canvas(
 	s32 shift_x = ((s32)bitmap_shift.x() * SG_MAP_MAX*2 + bitmap.width()/2) / bitmap.width();
 	s32 shift_y = ((s32)bitmap_shift.y() * SG_MAP_MAX*2 + bitmap.height()/2) / bitmap.height() * m_scale_sign_y;
 
-	if( m_aspect_ratio > 1.0f ){
-		height_scale /= m_aspect_ratio;
+	if( aspect_ratio > 1.0f ){
+		height_scale /= aspect_ratio;
 	} else {
-		width_scale *= m_aspect_ratio;
+		width_scale *= aspect_ratio;
 	}
 
 	map_shift = Point(
@@ -766,27 +1185,14 @@ Point SvgFontManager::convert_svg_coord(float x, float y, bool is_absolute){
 		temp_y = temp_y - m_scale_sign_y * SG_MAP_MAX/2.0f;
 	}
 
-	if( temp_x > SG_MAX ){
-		printer().message("Can't map this point x %0.2f > %d", temp_x, SG_MAX);
-		exit(1);
+	//only used by the tokenized parser -- out of range points are clamped instead of stopping
+	if( (temp_x > SG_MAX) || (temp_x < -1*SG_MAX) ||
+		 (temp_y > SG_MAX) || (temp_y < -1*SG_MAX) ){
+		printer().error("Can't map this point %0.2f,%0.2f (limit %d)", temp_x, temp_y, SG_MAX);
+		temp_x = temp_x > SG_MAX ? SG_MAX : (temp_x < -1*SG_MAX ? -1*SG_MAX : temp_x);
+		temp_y = temp_y > SG_MAX ? SG_MAX : (temp_y < -1*SG_MAX ? -1*SG_MAX : temp_y);
 	}
 
-	if( temp_y > SG_MAX ){
-		printer().message("Can't map this point y %0.2f > %d", temp_y, SG_MAX);
-		exit(1);
-	}
-
-	if( temp_x < -1*SG_MAX ){
-		printer().message("Can't map this point x %0.2f < %d", temp_x, -1*SG_MAX);
-		exit(1);
-	}
-
-	if( temp_y < -1*SG_MAX ){
-		printer().message("Can't map this point y %0.2f < %d", temp_y, -1*SG_MAX);
-		exit(1);
-	}
-
-
 	point.x = rintf(temp_x);
 	point.y = rintf(temp_y);
 
@@ -817,59 +1223,32 @@ Point SvgFontManager::calculate_canvas_origin(const Region & bounds, const Area
 }
 
 var::Vector<FillPoint> SvgFontManager::find_fill_point_candidates(
-		const Bitmap & bitmap,
+		const RunTable & run_table,
 		const Region & region,
 		sg_size_t grid_size,
 		bool is_negative_fill
 		){
 	var::Vector<FillPoint> result;
 
-	Bitmap debug_bitmap(
-				bitmap.area(),
-				Bitmap::BitsPerPixel(bits_per_pixel())
-				);
-	//debug_bitmap.set_bits_per_pixel(4);
-
-	debug_bitmap.clear();
-	debug_bitmap.set_pen( Pen().set_color(1) );
-	debug_bitmap.draw_bitmap(Point(0,0), bitmap);
-
-
-	EdgeDetector edge_detector(bitmap);
-
-	for(sg_int_t y = 1; y < bitmap.height(); y+=grid_size){
-		//process one line at a time
-		edge_detector.set_region(
-					Region(
-						Point(0,y),
-						Area(bitmap.width(), 1)
-						)
-					);
-
-		Point end_point = edge_detector.region().end_point();
-
-		var::Vector<Array<Point, 2>> edges;
-		Array<Point, 2> edge_pair;
-
-		if( is_negative_fill ){
-			edge_pair.at(0) = Point(0,0);
-			edge_pair.at(1) = Point(0,0);
-			edges.push_back(edge_pair);
-		}
-
-		do {
-			edge_pair.at(0) = edge_detector.find_next();
-			edge_pair.at(1) = edge_detector.find_next();
-			if( edge_pair.at(0) != edge_detector.region().end_point() ){
-				edges.push_back(edge_pair);
-			}
-		} while( edge_pair.at(1) != end_point );
-
-		for(size_t i = 1; i < edges.count(); i+=2){
-
-			/*	/0\ first edge pair
-			 * /1\ second edge pair
-			 * ----- fill area between even to odd pair
+	//the negative search starts with an empty stroke at the left edge
+	RowScanner::run_t left_edge;
+	left_edge.start = 0;
+	left_edge.end = 0;
+
+	for(sg_int_t y = 1; y < run_table.height(); y+=grid_size){
+		//process one line at a time -- each run is a stroke
+		const RowScanner::run_t * runs = run_table.begin(y);
+		const u32 offset = is_negative_fill ? 1 : 0;
+		const u32 edge_count = run_table.run_count(y) + offset;
+		auto edges = [&](u32 i) -> const RowScanner::run_t & {
+			return i < offset ? left_edge : runs[i - offset];
+		};
+
+		for(u32 i = 1; i < edge_count; i+=2){
+
+			/*	/0\ first stroke
+			 * /1\ second stroke
+			 * ----- fill area between even to odd stroke
 			 * | end of bitmap
 			 *
 			 * |   /0\---------/1\    /2\-------/3\    |
@@ -882,83 +1261,88 @@ var::Vector<FillPoint> SvgFontManager::find_fill_point_candidates(
 			 */
 			//
 
-			if( edges.at(i).at(0).x() != end_point.x() ){
-				//first candidate
-				result.push_back(
-							FillPoint(
-								Point(
-									(edges.at(i).at(0).x() - edges.at(i-1).at(1).x())/2 + edges.at(i-1).at(1).x(),
-									y
-									),
-								edges.at(i).at(0).x() - edges.at(i-1).at(1).x()
-								)
-							);
-			}
+			//the gap is the clear pixels from the end of one run to the start of the next
+			const sg_int_t gap_start = edges(i-1).end;
+			const sg_int_t gap_width = edges(i).start - gap_start;
+			result.push_back(
+						FillPoint(
+							Point(gap_width/2 + gap_start, y),
+							gap_width
+							)
+						);
 		}
 	}
 
 
-	debug_bitmap.set_pen( Pen().set_color(2) );
-	for(const auto & fill_point_candidate: result){
-		debug_bitmap.draw_pixel(fill_point_candidate.point());
-	}
+	if( is_debug() ){
+		ScratchBitmap scratch(run_table.area(), bits_per_pixel());
+		Bitmap & debug_bitmap = scratch.bitmap();
+		debug_bitmap.clear();
+		debug_bitmap.set_pen( Pen().set_color(1) );
+		for(sg_int_t y = 0; y < run_table.height(); y++){
+			for(const RowScanner::run_t * run = run_table.begin(y); run < run_table.end(y); run++){
+				debug_bitmap.draw_rectangle(Point(run->start, y), Area(run->end - run->start, 1));
+			}
+		}
 
-	if( is_negative_fill ){
-		printer().open_object("negative fill analysis", sys::Printer::DEBUG);
-	} else {
-		printer().open_object("fill analysis", sys::Printer::DEBUG);
+		debug_bitmap.set_pen( Pen().set_color(2) );
+		for(const auto & fill_point_candidate: result){
+			debug_bitmap.draw_pixel(fill_point_candidate.point());
+		}
+
+		if( is_negative_fill ){
+			printer().open_object("negative fill analysis", sys::Printer::DEBUG);
+		} else {
+			printer().open_object("fill analysis", sys::Printer::DEBUG);
+		}
+		printer() << debug_bitmap;
+		printer().close_object();
 	}
-	printer() << debug_bitmap;
-	printer().close_object();
 
 	return result;
 }
 
 
 var::Vector<var::Vector<FillPoint>> SvgFontManager::group_fill_point_candidates(
-		const Bitmap & bitmap,
+		const RegionMap & region_map,
 		var::Vector<FillPoint> & fill_points
 		){
 
 	var::Vector<var::Vector<FillPoint>> result;
 
+	//points that a pour from the same point would reach share a label
+	var::Vector<int> label_group;
+	label_group.resize(region_map.region_count() + 1);
+	for(auto & group: label_group){
+		group = -1;
+	}
+
 	int group_count = 0;
 	for(u32 i=0; i < fill_points.count(); i++){
 		FillPoint & fill_point = fill_points.at(i);
-		if( fill_point.group() < 0 ){
-			Bitmap fill_bitmap(
-						bitmap.area(),
-						Bitmap::BitsPerPixel(1)
-						);
-			Region active_region;
-			Region pour_active_region;
-			fill_bitmap.clear();
-			fill_bitmap.set_pen( Pen().set_color(1) );
-			fill_bitmap.draw_bitmap(Point(0,0), bitmap);
-			active_region = bitmap.calculate_active_region();
-			fill_bitmap.draw_pour(fill_point.point(), fill_bitmap.region());
-			pour_active_region = bitmap.calculate_active_region();
-
-			fill_point.set_group(group_count);
-			printer().open_object(
-						String().format(
-							"fill %d,%d",
-							fill_point.point().x(),
-							fill_point.point().y()
-							),
-						sys::Printer::DEBUG
-						);
-			printer() << fill_bitmap;
-			printer().close_object();
+		u32 label = region_map.label(fill_point.point());
 
-			for(size_t j = i+1; j < fill_points.count(); j++){
-				FillPoint & check_point = fill_points.at(j);
-				if( fill_bitmap.get_pixel(check_point.point()) != 0 ){
-					check_point.set_group(group_count);
-				}
+		//a point on the glyph is inside every pour (the pour canvas holds
+		//a copy of the glyph) so it ends up in the last group started
+		if( label == RegionMap::FOREGROUND ){
+			if( group_count == 0 ){
+				group_count++;
 			}
-			group_count++;
+			fill_point.set_group(group_count-1);
+			continue;
+		}
+
+		if( label_group.at(label) < 0 ){
+			label_group.at(label) = group_count++;
+			printer().debug(
+						"fill %d,%d starts group %d (region %d)",
+						fill_point.point().x(),
+						fill_point.point().y(),
+						label_group.at(label),
+						label
+						);
 		}
+		fill_point.set_group(label_group.at(label));
 	}
 
 	for(int group = 0; group < group_count; group++){
@@ -979,58 +1363,10 @@ var::Vector<var::Vector<FillPoint>> SvgFontManager::group_fill_point_candidates(
 
 }
 
-sg_size_t SvgFontManager::get_y_fill_spacing(
-		const Bitmap & bitmap,
-		Point point
-		){
-
-	sg_size_t top_spacing = 0;
-	sg_size_t bottom_spacing = 0;
-	sg_color_t pixel;
-	Point start_point = point;
-	do {
-		pixel = bitmap.get_pixel(point);
-		bottom_spacing++;
-		point += Point::Y(1);
-	} while(
-			  (pixel == 0) && (point.y() < bitmap.height())
-			  );
-
-	//hits bottom without finding a pixel
-	if(( point.y() == bitmap.height()) &&
-			(pixel == 0) ){
-		return 0;
-	}
-
-	point = start_point;
-
-	do {
-		pixel = bitmap.get_pixel(point);
-		top_spacing++;
-		point -= Point::Y(1);
-	} while(
-			  (pixel == 0) && (point.y() > 0)
-			  );
-
-	//hits top without finding a pixel
-	if( (point.y() == 0) &&
-		 (pixel == 0) ){
-		return 0;
-	}
-
-	sg_size_t spacing = top_spacing < bottom_spacing ? top_spacing : bottom_spacing;
-	printer().debug(
-				"point %d, %d y spacing = %d ",
-				start_point.x(),
-				start_point.y(),
-				spacing
-				);
-
-	return spacing;
-}
-
 var::Vector<Point> SvgFontManager::find_final_fill_points(
-		const Bitmap & bitmap,
+		const RunTable & run_table,
+		const RegionMap & region_map,
+		DistanceMap & distance_map,
 		var::Vector<var::Vector<FillPoint>> & fill_point_groups,
 		const var::Vector<var::Vector<FillPoint>> & negative_fill_point_groups
 		){
@@ -1045,53 +1381,12 @@ var::Vector<Point> SvgFontManager::find_final_fill_points(
 							  group.count())
 						  );
 		for(const auto & negative_group: negative_fill_point_groups){
-			PRINTER_TRACE(printer(),
-							  String().format(
-								  "create fill bitmap with area %dx%d",
-								  bitmap.width(), bitmap.height()
-								  )
-							  );
-
-			Bitmap fill_bitmap(
-						bitmap.area(),
-						Bitmap::BitsPerPixel(1)
-						);
-
-			PRINTER_TRACE(printer(),
-							  String().format(
-								  "looking at pour point %d,%d",
-								  negative_group.at(0).point().x(),
-								  negative_group.at(0).point().y()
-								  )
-							  );
-
-			fill_bitmap.clear();
-			PRINTER_TRACE(printer(), "draw bitmap");
-			fill_bitmap.draw_bitmap(Point(0,0), bitmap);
-			PRINTER_TRACE(printer(),
-							  String().format(
-								  "draw pour %d,%d in region %d,%d %dx%d -> %p",
-								  negative_group.at(0).point().x(),
-								  negative_group.at(0).point().y(),
-								  fill_bitmap.region().x(),
-								  fill_bitmap.region().y(),
-								  fill_bitmap.region().width(),
-								  fill_bitmap.region().height(),
-								  fill_bitmap.data()
-								  )
-							  );
-
-			fill_bitmap.draw_pour(
-						negative_group.at(0).point(),
-						fill_bitmap.region()
-						);
-
-			PRINTER_TRACE(
-						printer(),
-						"check fill points in group"
-						);
+			//a pour from the negative group reaches its own region and
+			//the glyph is always set
+			u32 negative_label = region_map.label(negative_group.at(0).point());
 			for(auto & fill_point: group){
-				if( fill_bitmap.get_pixel(fill_point.point()) != 0 ){
+				u32 label = region_map.label(fill_point.point());
+				if( (label == RegionMap::FOREGROUND) || (label == negative_label) ){
 					printer().debug("%d:%d,%d overlaps with negative group %d (%d > %d)",
 										 fill_point.group(),
 										 fill_point.point().x(),
@@ -1109,33 +1404,82 @@ var::Vector<Point> SvgFontManager::find_final_fill_points(
 	}
 
 
-	//for each group find the point with the max spacing -- need to to search y edges
+	//for each group find the best point -- y spacing comes from the region map
+	u32 window_label = RegionMap::FOREGROUND;
 	for(const auto & group: fill_point_groups){
 
 		sg_size_t spacing = 0;
+		u16 distance = 0;
 		size_t best_point = 0;
 
 		for(size_t i=0; i < group.count(); i++){
-			if( group.at(i).group() >= 0 ){
-				sg_size_t x_spacing = group.at(i).spacing();
-				if( x_spacing > spacing ){
-					sg_size_t y_spacing = get_y_fill_spacing(bitmap, group.at(i).point());
-					if( y_spacing > spacing ){
-						spacing = x_spacing > y_spacing ? y_spacing : x_spacing;
-						best_point = i;
+			if( group.at(i).group() < 0 ){
+				continue;
+			}
+
+			sg_size_t x_spacing = group.at(i).spacing();
+			if( m_pour_select == POUR_SELECT_DISTANCE ){
+				//points in an open column are still skipped
+				sg_size_t y_spacing = region_map.y_spacing(group.at(i).point());
+				if( (x_spacing == 0) || (y_spacing == 0) ){
+					continue;
+				}
+
+				if( m_is_multires ){
+					//distances are only needed around the point's region
+					u32 label = region_map.label(group.at(i).point());
+					if( label == RegionMap::FOREGROUND ){
+						continue;
+					}
+					if( label != window_label ){
+						Region bounds = region_map.bounds(label);
+						sg_int_t left = bounds.point().x() > 0 ? bounds.point().x() - 1 : 0;
+						sg_int_t top = bounds.point().y() > 0 ? bounds.point().y() - 1 : 0;
+						sg_int_t right = bounds.point().x() + bounds.area().width() + 1;
+						sg_int_t bottom = bounds.point().y() + bounds.area().height() + 1;
+						if( right > run_table.width() ){ right = run_table.width(); }
+						if( bottom > run_table.height() ){ bottom = run_table.height(); }
+						distance_map.calculate(
+									run_table,
+									Region(Point(left, top), Area(right - left, bottom - top))
+									);
+						window_label = label;
 					}
 				}
+
+				u16 point_distance = distance_map.at(group.at(i).point());
+				if( point_distance > distance ){
+					distance = point_distance;
+					spacing = x_spacing > y_spacing ? y_spacing : x_spacing;
+					best_point = i;
+				}
+			} else if( x_spacing > spacing ){
+				sg_size_t y_spacing = region_map.y_spacing(group.at(i).point());
+				if( y_spacing > spacing ){
+					spacing = x_spacing > y_spacing ? y_spacing : x_spacing;
+					best_point = i;
+				}
 			}
 		}
 
 		if( (spacing > 0) && (group.count() > 2) ){
 			const FillPoint & fill_point = group.at(best_point);
-			printer().message(
-						"adding final fill point %d,%d with in spacing %d",
-						fill_point.point().x(),
-						fill_point.point().y(),
-						spacing
-						);
+			if( m_pour_select == POUR_SELECT_DISTANCE ){
+				printer().message(
+							"adding final fill point %d,%d with in spacing %d (distance %0.1f)",
+							fill_point.point().x(),
+							fill_point.point().y(),
+							spacing,
+							distance * 1.0f / DistanceMap::ORTHOGONAL
+							);
+			} else {
+				printer().message(
+							"adding final fill point %d,%d with in spacing %d",
+							fill_point.point().x(),
+							fill_point.point().y(),
+							spacing
+							);
+			}
 			result.push_back(fill_point.point());
 		}
 	}
@@ -1143,16 +1487,114 @@ var::Vector<Point> SvgFontManager::find_final_fill_points(
 	return result;
 }
 
+void SvgFontManager::classify_fill_point_candidates(
+		const WindingIndex & winding_index,
+		var::Vector<FillPoint> & fill_points,
+		var::Vector<FillPoint> & negative_fill_points
+		){
+	//together the two searches hold every gap -- sort them by winding number
+	var::Vector<FillPoint> inside;
+	var::Vector<FillPoint> outside;
+	u32 moved_count = 0;
+	for(const auto & fill_point: fill_points){
+		if( winding_index.is_inside(fill_point.point()) ){
+			inside.push_back(fill_point);
+		} else {
+			outside.push_back(fill_point);
+			moved_count++;
+		}
+	}
+
+	for(const auto & fill_point: negative_fill_points){
+		if( winding_index.is_inside(fill_point.point()) ){
+			inside.push_back(fill_point);
+			moved_count++;
+		} else {
+			outside.push_back(fill_point);
+		}
+	}
+
+	printer().debug("winding test moved %d of %d candidates",
+						 moved_count,
+						 fill_points.count() + negative_fill_points.count()
+						 );
+
+	fill_points = inside;
+	negative_fill_points = outside;
+}
+
+sg_size_t SvgFontManager::select_pour_grid_size(
+		const RegionMap & region_map,
+		sg_size_t & region_height
+		){
+	//every region between the strokes spans a range of rows without gaps
+	//so a grid that fits POUR_GRID_ROWS times in the range cannot miss it
+	region_height = 0;
+	for(u32 label = 1; label <= region_map.region_count(); label++){
+		const Region bounds = region_map.bounds(label);
+		const u32 right = bounds.point().x() + bounds.area().width();
+		const u32 bottom = bounds.point().y() + bounds.area().height();
+
+		//regions open to the edge of the canvas are outside of the glyph
+		if( (bounds.point().x() == 0) || (bounds.point().y() == 0) ||
+			 (right == region_map.width()) || (bottom == region_map.height()) ){
+			continue;
+		}
+
+		//too short to get a pour point on any grid
+		if( bounds.area().height() < POUR_GRID_ROWS ){
+			continue;
+		}
+
+		if( (region_height == 0) || (bounds.area().height() < region_height) ){
+			region_height = bounds.area().height();
+		}
+	}
+
+	if( region_height == 0 ){
+		return POUR_GRID_MAX;
+	}
+
+	sg_size_t grid = region_height / POUR_GRID_ROWS;
+	if( grid > POUR_GRID_MAX ){
+		grid = POUR_GRID_MAX;
+	}
+	return grid;
+}
+
 var::Vector<Point> SvgFontManager::find_all_fill_points(
 		const Bitmap & bitmap,
 		const Region & region,
-		sg_size_t grid
+		sg_size_t grid,
+		const WindingIndex * winding_index
 		){
 
+	//the maps keep their memory from the last glyph on this thread
+	ScratchPool & pool = ScratchPool::get();
+
+	//the only pass over the canvas -- every stage below reads the runs
+	PRINTER_TRACE(printer(), "scan rows");
+	RunTable & run_table = pool.run_table();
+	run_table.calculate(bitmap);
+
+	PRINTER_TRACE(printer(), "label regions");
+	RegionMap & region_map = pool.region_map();
+	region_map.calculate(run_table, m_is_multires == false);
+
+	if( m_is_pour_grid_auto ){
+		sg_size_t region_height;
+		grid = select_pour_grid_size(region_map, region_height);
+		printer().debug(
+					"pour grid %d for shortest region of %d rows",
+					grid,
+					region_height
+					);
+	}
+
 	PRINTER_TRACE(printer(), "find candidates");
 	var::Vector<FillPoint> candidates
 			= find_fill_point_candidates(
-				bitmap,
+				run_table,
 				region,
 				grid,
 				false
@@ -1161,29 +1603,55 @@ var::Vector<Point> SvgFontManager::find_all_fill_points(
 	PRINTER_TRACE(printer(), "find negative candidates");
 	var::Vector<FillPoint> negative_candidates
 			= find_fill_point_candidates(
-				bitmap,
+				run_table,
 				region,
 				grid,
 				true
 				);
 
+	if( winding_index ){
+		classify_fill_point_candidates(
+					*winding_index,
+					candidates,
+					negative_candidates
+					);
+	}
+
 	PRINTER_TRACE(printer(), "group candidates");
 	var::Vector<Vector<FillPoint>> grouped_candidates
 			= group_fill_point_candidates(
-				bitmap,
+				region_map,
 				candidates
 				);
 
 	PRINTER_TRACE(printer(), "group negative candidates");
 	var::Vector<Vector<FillPoint>> negative_grouped_candidates
 			= group_fill_point_candidates(
-				bitmap,
+				region_map,
 				negative_candidates
 				);
 
+	PRINTER_TRACE(printer(), "distance transform");
+	DistanceMap & distance_map = pool.distance_map();
+	if( m_is_multires ){
+		//calculated for each region in find_final_fill_points()
+	} else if( m_pour_select == POUR_SELECT_DISTANCE ){
+		distance_map.calculate(run_table, Region(Point(0,0), run_table.area()));
+	}
+
+	if( is_debug() && (m_is_multires == false) && (m_pour_select == POUR_SELECT_DISTANCE) ){
+		ScratchBitmap scratch(bitmap.area(), 4);
+		distance_map.draw(scratch.bitmap());
+		printer().open_object("distance map", Printer::DEBUG);
+		printer() << scratch.bitmap();
+		printer().close_object();
+	}
+
 	PRINTER_TRACE(printer(), "find final fill points");
 	var::Vector<Point> fill_points = find_final_fill_points(
-				bitmap,
+				run_table,
+				region_map,
+				distance_map,
 				grouped_candidates,
 				negative_grouped_candidates
 				);
@@ -1195,165 +1663,176 @@ var::Vector<Point> SvgFontManager::find_all_fill_points(
 }
 
 sg_size_t SvgFontManager::is_fill_point(
-		const Bitmap & bitmap,
+		const RunTable & run_table,
 		sg_point_t point,
 		const Region & region
 		){
 
-	int boundary_count;
-	sg_color_t color;
-	sg_point_t temp = point;
-
-	color = bitmap.get_pixel(point);
-	if( color != 0 ){
-		return false;
+	if( run_table.is_set(point) ){
+		return 0;
 	}
 
-	sg_size_t width;
-	sg_size_t height;
-
-	sg_size_t spacing;
-
-	width = region.point().x() + region.area().width();
-	height = region.point().y() + region.area().height();
+	sg_size_t spacing = 0xffff;
 
-	boundary_count = 0;
-
-	Cursor y_cursor(bitmap, region.point());
-
-	do {
-		Cursor x_cursor = y_cursor;
-
-		//look for positive edge
-		while( (temp.x < width) && (bitmap.get_pixel(temp) == 0) ){
-			temp.x++;
-		}
-
-		spacing = temp.x - point.x;
-
-		printer().debug(
-					"-- spacing is %d vs %d",
-					spacing,
-					x_cursor.find_positive_edge(width)
-					);
-
-		if( temp.x < width ){
-			boundary_count++;
-			while( (temp.x < width) && (bitmap.get_pixel(temp) != 0) ){
-				temp.x++;
-			}
-
-			if( temp.x < width ){
-			}
-		}
-	} while( temp.x < width );
-
-	if ((boundary_count % 2) == 0){
-		return false;
+	//inside means an odd number of strokes in all four directions
+	if( is_inside_runs(
+			 run_table.begin(point.y),
+			 run_table.end(point.y),
+			 point.x,
+			 region.point().x(),
+			 region.point().x() + region.area().width(),
+			 spacing) == false ){
+		return 0;
 	}
 
-	temp = point;
-	boundary_count = 0;
-	do {
-		while( (temp.x >= region.point().x()) && (bitmap.get_pixel(temp) == 0) ){
-			temp.x--;
-		}
-
-		//distance to first boundary
-		if( point.x - temp.x < spacing ){
-			spacing = point.x - temp.x;
-		}
-
-		if( temp.x >= region.point().x() ){
-			boundary_count++;
-			while( (temp.x >= region.point().x()) && (bitmap.get_pixel(temp) != 0) ){
-				temp.x--;
-			}
-
-			if( temp.x >= region.point().x() ){
-			}
-		}
-	} while( temp.x >= region.point().x() );
-
-	if ((boundary_count % 2) == 0){
+	std::vector<RowScanner::run_t> runs;
+	run_table.scan_column(point.x, runs);
+	if( is_inside_runs(
+			 runs.data(),
+			 runs.data() + runs.size(),
+			 point.y,
+			 region.point().y(),
+			 region.point().y() + region.area().height(),
+			 spacing) == false ){
 		return 0;
 	}
 
-	temp = point;
-	boundary_count = 0;
-	do {
-		while( (temp.y >= region.point().y()) && (bitmap.get_pixel(temp) == 0) ){
-			temp.y--;
-		}
+	return spacing;
+}
 
-		//distance to first boundary
-		if( point.y - temp.y < spacing ){
-			spacing = point.y - temp.y;
+bool SvgFontManager::is_inside_runs(
+		const RowScanner::run_t * first_run,
+		const RowScanner::run_t * last_run,
+		sg_int_t position,
+		sg_int_t low,
+		sg_int_t high,
+		sg_size_t & spacing
+		){
+	u32 before_count = 0;
+	u32 after_count = 0;
+	sg_int_t before_edge = low - 1; //last set pixel before position
+	sg_int_t after_edge = high; //first set pixel after position
+
+	for(const RowScanner::run_t * run = first_run; run < last_run; run++){
+		sg_int_t start = run->start < low ? low : run->start;
+		sg_int_t end = run->end > high ? high : run->end;
+		if( start >= end ){
+			continue;
 		}
 
-
-		if( temp.y >= region.point().y() ){
-			boundary_count++;
-			while( (temp.y >= region.point().y()) && (bitmap.get_pixel(temp) != 0) ){
-				temp.y--;
-			}
-
-			if( temp.y >= region.point().y() ){
+		if( end <= position ){
+			before_count++;
+			before_edge = end - 1;
+		} else if( start > position ){
+			if( after_count == 0 ){
+				after_edge = start;
 			}
+			after_count++;
 		}
-	} while( temp.y >= region.point().y() );
-
-	if ((boundary_count % 2) == 0){
-		return 0;
 	}
 
-	//return spacing;
+	if( ((before_count % 2) == 0) || ((after_count % 2) == 0) ){
+		return false;
+	}
 
-	temp = point;
-	boundary_count = 0;
-	do {
-		while( (temp.y < height) && (bitmap.get_pixel(temp) == 0) ){
-			temp.y++;
-		}
+	//distance to the first boundary on each side
+	if( position - before_edge < spacing ){
+		spacing = position - before_edge;
+	}
+	if( after_edge - position < spacing ){
+		spacing = after_edge - position;
+	}
+	return true;
+}
 
-		//distance to first boundary
-		if( temp.y - point.y < spacing ){
-			spacing = temp.y - point.y;
-		}
+float SvgFontManager::calculate_flatness() const {
+	if( m_flatness > 0.0f ){
+		return m_flatness;
+	}
 
+	//a quarter of an output pixel
+	sg_size_t factor = m_downsample.width() < m_downsample.height() ?
+				m_downsample.width() :
+				m_downsample.height();
+	if( factor == 0 ){
+		factor = 1;
+	}
+	return factor * PathGeometry::DEFAULT_TOLERANCE;
+}
 
-		if( temp.y < height ){
-			boundary_count++;
-			while( (temp.y < height) && (bitmap.get_pixel(temp) != 0) ){
-				temp.y++;
-			}
+u32 SvgFontManager::flatten_path(
+		PathGeometry & geometry,
+		const var::Vector<sg_vector_path_description_t> & elements,
+		const Region & region
+		){
+	geometry.set_tolerance(calculate_flatness());
+	u32 result = geometry.flatten(elements, region);
+	printer().debug(
+				"flattened %d curves to %d segments (flatness %0.2f)",
+				geometry.curve_count(),
+				result,
+				geometry.tolerance()
+				);
+	return result;
+}
 
-			if( temp.y < height ){
-			}
-		}
-	} while( temp.y < height );
+var::Vector<sg_vector_path_description_t> SvgFontManager::convert_svg_path(
+		Bitmap & canvas,
+		const char * d,
+		u32 d_length,
+		const Area & canvas_dimensions,
+		sg_size_t grid_size,
+		bool is_fit_icon,
+		Point & canvas_offset,
+		enum item_status * status
+		){
 
-	if ((boundary_count % 2) == 0){
-		return 0;
+	var::Vector<sg_vector_path_description_t> elements =
+			process_svg_path(d, d_length, status);
+	if( status && (*status != ITEM_STATUS_OK) ){
+		canvas_offset = Point(0,0);
+		return var::Vector<sg_vector_path_description_t>();
 	}
 
-	return spacing;
-
+	return convert_svg_path(
+				canvas,
+				elements,
+				canvas_dimensions,
+				grid_size,
+				is_fit_icon,
+				canvas_offset,
+				m_aspect_ratio
+				);
 }
 
 var::Vector<sg_vector_path_description_t> SvgFontManager::convert_svg_path(
 		Bitmap & canvas,
-		const var::String & d,
+		var::Vector<sg_vector_path_description_t> elements,
 		const Area & canvas_dimensions,
 		sg_size_t grid_size,
-		bool is_fit_icon
+		bool is_fit_icon,
+		Point & canvas_offset,
+		float aspect_ratio
 		){
 
-	var::Vector<sg_vector_path_description_t> elements;
-
-	elements = process_svg_path(d);
+	canvas_offset = Point(0,0);
 	if( elements.count() > 0 ){
-		canvas.allocate(canvas_dimensions);
+		//glyphs only need a canvas as large as the path -- icons are
+		//drawn on the full canvas and fitted to it
+		const Region full_region(Point(0,0), canvas_dimensions);
+		Region path_region;
+		PathGeometry::bounds_t bounds;
+		if( (is_fit_icon == false) && PathGeometry::calculate_bounds(elements, bounds) ){
+			path_region = PathGeometry::map_bounds(bounds, full_region);
+		}
+
+		if( path_region.area().width() ){
+			const Region window = calculate_canvas_window(path_region, canvas_dimensions, grid_size);
+			canvas_offset = window.point();
+			canvas.allocate(window.area());
+		} else {
+			canvas.allocate(canvas_dimensions);
+		}
 
 		canvas.set_pen(
 					Pen().set_color(0xffffffff)
@@ -1361,22 +1840,65 @@ var::Vector<sg_vector_path_description_t> SvgFontManager::convert_svg_path(
 					.set_fill(true)
 					);
 
+		//the full canvas is mapped and the bitmap is a window onto it
+		const Region map_region(
+					Point(-1*canvas_offset.x(), -1*canvas_offset.y()),
+					canvas_dimensions
+					);
 		VectorMap map;
-		map.calculate_for_bitmap(canvas);
+		map.calculate_for_region(map_region);
+
+		//glyph curves are drawn as lines at the flatness -- icons keep
+		//the curves because they are what is stored
+		var::Vector<sg_vector_path_description_t> line_elements;
 		sgfx::VectorPath vector_path;
-		vector_path << elements << canvas.get_viewable_region();
+		if( is_fit_icon ){
+			//the fit shifts and scales the bound elements so they are stored fitted
+			vector_path << elements << canvas.get_viewable_region();
+		} else {
+			PathGeometry line_geometry;
+			line_geometry.set_tolerance(calculate_flatness());
+			line_elements = line_geometry.flatten_to_lines(elements, map_region);
+			printer().debug(
+						"drawing %d curves as %d elements (flatness %0.2f)",
+						line_geometry.curve_count(),
+						line_elements.count(),
+						line_geometry.tolerance()
+						);
+			vector_path << line_elements << canvas.get_viewable_region();
+		}
 
 		canvas.clear();
 		map.set_rotation(0);
-		sgfx::Vector::draw(canvas, vector_path, map);
-
 		if( is_fit_icon ){
 			printer().message("fit icon to canvas %dx%d", canvas.width(), canvas.height());
-			fit_icon_to_canvas(canvas, vector_path, map);
+			fit_icon_to_canvas(canvas, vector_path, map, aspect_ratio);
+		} else {
+			sgfx::Vector::draw(canvas, vector_path, map);
+		}
+
+		if( (m_fill == FILL_SCANLINE) && (is_fit_icon == false) ){
+			//the outline is already drawn -- fill the inside by winding rule
+			PathGeometry geometry;
+			flatten_path(geometry, elements, map_region);
+			ScanlineRasterizer(geometry, m_fill_rule).fill(canvas);
+			return elements;
 		}
 
 		var::Vector<Point> fill_points;
-		fill_points = find_all_fill_points(canvas, canvas.get_viewable_region(), grid_size);
+		if( (m_pour_test == POUR_TEST_WINDING) && (is_fit_icon == false) ){
+			PathGeometry geometry;
+			flatten_path(geometry, elements, map_region);
+			WindingIndex winding_index(geometry, canvas.height(), m_fill_rule);
+			fill_points = find_all_fill_points(
+						canvas,
+						canvas.get_viewable_region(),
+						grid_size,
+						&winding_index
+						);
+		} else {
+			fill_points = find_all_fill_points(canvas, canvas.get_viewable_region(), grid_size);
+		}
 		printer().message(
 					"found %d fill points",
 					fill_points.count()
@@ -1395,9 +1917,12 @@ var::Vector<sg_vector_path_description_t> SvgFontManager::convert_svg_path(
 						);
 
 			elements.push_back(sgfx::Vector::get_path_pour(pour_point));
+			if( is_fit_icon == false ){
+				line_elements.push_back(sgfx::Vector::get_path_pour(pour_point));
+			}
 		}
 
-		vector_path << elements << canvas.get_viewable_region();
+		vector_path << (is_fit_icon ? elements : line_elements) << canvas.get_viewable_region();
 		canvas.clear();
 		printer().open_object("vector path", Printer::DEBUG) << vector_path;
 		printer().close_object();
@@ -1413,22 +1938,308 @@ var::Vector<sg_vector_path_description_t> SvgFontManager::convert_svg_path(
 						);
 			canvas.draw_pixel(fill_points.at(i));
 		}
+	}
+
+	return elements;
+}
+
+
+var::Vector<sg_vector_path_description_t> SvgFontManager::process_svg_path(
+		const String & path
+		){
+	return process_svg_path(path.cstring(), path.length());
+}
+
+var::Vector<sg_vector_path_description_t> SvgFontManager::process_svg_path(
+		const char * path,
+		u32 length,
+		enum item_status * status
+		){
+	return process_svg_path(path, length, m_scale, status);
+}
+
+var::Vector<sg_vector_path_description_t> SvgFontManager::process_svg_path(
+		const char * path,
+		u32 length,
+		float scale,
+		enum item_status * status
+		){
+
+	var::Vector<sg_vector_path_description_t> result;
+	SvgPathLexer lexer(path, length);
+	CoordinateBatch & batch = ScratchPool::get().coordinate_batch();
+	char command_char = 0;
+	enum item_status path_status = ITEM_STATUS_OK;
+
+	//commands and raw coordinates are collected first then mapped together
+	batch.clear();
+	batch.set_transform(scale, m_scale_sign_y);
+	while( lexer.is_end() == false ){
+		float args[7];
+		char next_command;
+
+		if( lexer.parse_command(next_command) ){
+			command_char = next_command;
+		} else {
+			//values without a command repeat the previous command
+			switch(command_char){
+				case 'M': command_char = 'L'; break;
+				case 'm': command_char = 'l'; break;
+				case 0:
+				case 'Z':
+				case 'z':
+					printer().warning(
+								"Unexpected value at offset %d",
+								lexer.offset()
+								);
+					path_status = ITEM_STATUS_PARSE_FAILED;
+					command_char = 0;
+					break;
+			}
+			if( command_char == 0 ){
+				break;
+			}
+		}
 
-		Region active_region = canvas.calculate_active_region();
+		int count = parse_svg_path_arguments(lexer, command_char, args);
+		if( count < 0 ){
+			printer().warning(
+						"Unhandled command char %c at offset %d",
+						command_char,
+						lexer.offset()
+						);
+			path_status = ITEM_STATUS_PARSE_FAILED;
+			break;
+		}
+
+		//a relative moveto that starts the path is absolute (the pairs after it are still relative)
+		const char batch_command =
+				((command_char == 'm') && (batch.command_count() == 0)) ? 'M' : command_char;
+		const bool is_absolute = (batch_command >= 'A') && (batch_command <= 'Z');
+		batch.add_command(batch_command);
+		switch(batch_command){
+			case 'H':
+			case 'h':
+				batch.add(args[0], 0, is_absolute);
+				break;
+			case 'V':
+			case 'v':
+				batch.add(0, args[0], is_absolute);
+				break;
+			case 'A':
+			case 'a':
+				//arcs are approximated with a line to the end point
+				batch.add(args[5], args[6], is_absolute);
+				break;
+			default:
+				for(int i=0; i+1 < count; i+=2){
+					batch.add(args[i], args[i+1], is_absolute);
+				}
+				break;
+		}
+	}
 
-		Bitmap active_bitmap(
-					active_region.area(),
-					Bitmap::BitsPerPixel(1)
+	u32 out_of_range = batch.transform();
+	if( out_of_range ){
+		printer().error(
+					"Can't map %ld of %ld path points (x %0.2f to %0.2f, y %0.2f to %0.2f, limit %d)",
+					out_of_range,
+					batch.count(),
+					batch.x_min(),
+					batch.x_max(),
+					batch.y_min(),
+					batch.y_max(),
+					SG_MAX
 					);
-		active_bitmap.clear();
-		active_bitmap.draw_sub_bitmap(Point(), canvas, active_region);
+		if( status ){ *status = ITEM_STATUS_OUT_OF_RANGE; }
+		return result;
 	}
 
-	return elements;
+	//the elements before a parse error are still returned
+	if( status ){ *status = path_status; }
+
+	Point current_point, control_point;
+	Point move_point;
+	u32 k = 0;
+	for(u32 i=0; i < batch.command_count(); i++){
+		Point p;
+		Point points[3];
+
+		command_char = batch.command(i);
+		switch(command_char){
+			case 'M':
+				current_point = batch.at(k++);
+				move_point = current_point;
+				control_point = current_point;
+				result.push_back(sgfx::Vector::get_path_move(current_point));
+				break;
+			case 'm':
+				current_point += batch.at(k++);
+				move_point = current_point;
+				control_point = current_point;
+				result.push_back(sgfx::Vector::get_path_move(current_point));
+				break;
+			case 'L':
+			case 'l':
+			case 'A':
+			case 'a':
+				p = batch.at(k++);
+				if( (command_char == 'l') || (command_char == 'a') ){ p += current_point; }
+				result.push_back(sgfx::Vector::get_path_line(p));
+				current_point = p;
+				control_point = current_point;
+				break;
+			case 'H':
+				p = Point(batch.at(k++).x(), current_point.y());
+				result.push_back(sgfx::Vector::get_path_line(p));
+				current_point = p;
+				control_point = current_point;
+				break;
+			case 'h':
+				p = Point(current_point.x() + batch.at(k++).x(), current_point.y());
+				result.push_back(sgfx::Vector::get_path_line(p));
+				current_point = p;
+				control_point = current_point;
+				break;
+			case 'V':
+				p = Point(current_point.x(), batch.at(k++).y());
+				result.push_back(sgfx::Vector::get_path_line(p));
+				current_point = p;
+				control_point = current_point;
+				break;
+			case 'v':
+				p = Point(current_point.x(), current_point.y() + batch.at(k++).y());
+				result.push_back(sgfx::Vector::get_path_line(p));
+				current_point = p;
+				control_point = current_point;
+				break;
+			case 'C':
+				points[0] = batch.at(k++);
+				points[1] = batch.at(k++);
+				points[2] = batch.at(k++);
+				result.push_back(sgfx::Vector::get_path_cubic_bezier(points[0], points[1], points[2]));
+				control_point = points[1];
+				current_point = points[2];
+				break;
+			case 'c':
+				points[0] = current_point + batch.at(k++);
+				points[1] = current_point + batch.at(k++);
+				points[2] = current_point + batch.at(k++);
+				result.push_back(sgfx::Vector::get_path_cubic_bezier(points[0], points[1], points[2]));
+				control_point = points[1];
+				current_point = points[2];
+				break;
+			case 'S':
+			case 's':
+				//first point is a reflection of the current point
+				points[0] = Point(2*current_point.x() - control_point.x(), 2*current_point.y() - control_point.y());
+				if( command_char == 'S' ){
+					points[1] = batch.at(k++);
+					points[2] = batch.at(k++);
+				} else {
+					points[1] = current_point + batch.at(k++);
+					points[2] = current_point + batch.at(k++);
+				}
+				result.push_back(sgfx::Vector::get_path_cubic_bezier(points[0], points[1], points[2]));
+				control_point = points[1];
+				current_point = points[2];
+				break;
+			case 'Q':
+			case 'q':
+				if( command_char == 'Q' ){
+					points[0] = batch.at(k++);
+					points[1] = batch.at(k++);
+				} else {
+					points[0] = current_point + batch.at(k++);
+					points[1] = current_point + batch.at(k++);
+				}
+				result.push_back(sgfx::Vector::get_path_quadratic_bezier(points[0], points[1]));
+				control_point = points[0];
+				current_point = points[1];
+				break;
+			case 'T':
+			case 't':
+				points[0] = Point(2*current_point.x() - control_point.x(), 2*current_point.y() - control_point.y());
+				if( command_char == 'T' ){
+					points[1] = batch.at(k++);
+				} else {
+					points[1] = current_point + batch.at(k++);
+				}
+				result.push_back(sgfx::Vector::get_path_quadratic_bezier(points[0], points[1]));
+				control_point = points[0];
+				current_point = points[1];
+				break;
+			case 'Z':
+			case 'z':
+				result.push_back(sgfx::Vector::get_path_close());
+				current_point = move_point;
+				control_point = current_point;
+				break;
+		}
+	}
+
+	printer().debug("parsed %d path elements", result.count());
+	return result;
 }
 
+int SvgFontManager::parse_svg_path_arguments(
+		SvgPathLexer & lexer,
+		char command,
+		float * args
+		){
+	int count;
+	switch(command){
+		case 'Z':
+		case 'z':
+			return 0;
+		case 'H':
+		case 'h':
+		case 'V':
+		case 'v':
+			count = 1;
+			break;
+		case 'M':
+		case 'm':
+		case 'L':
+		case 'l':
+		case 'T':
+		case 't':
+			count = 2;
+			break;
+		case 'S':
+		case 's':
+		case 'Q':
+		case 'q':
+			count = 4;
+			break;
+		case 'C':
+		case 'c':
+			count = 6;
+			break;
+		case 'A':
+		case 'a':
+			count = 7;
+			break;
+		default:
+			return -1;
+	}
 
-var::Vector<sg_vector_path_description_t> SvgFontManager::process_svg_path(
+	for(int i=0; i < count; i++){
+		if( (command == 'A' || command == 'a') && (i == 3 || i == 4) ){
+			bool flag;
+			if( lexer.parse_flag(flag) == false ){
+				return -1;
+			}
+			args[i] = flag ? 1.0f : 0.0f;
+		} else if( lexer.parse_number(args[i]) == false ){
+			return -1;
+		}
+	}
+
+	return count;
+}
+
+var::Vector<sg_vector_path_description_t> SvgFontManager::process_svg_path_tokenized(
 		const String & path
 		){
 
@@ -1514,7 +2325,12 @@ var::Vector<sg_vector_path_description_t> SvgFontManager::process_svg_path(
 				//ret = parse_path_moveto_relative(d+i);
 				x = arg;
 				y = path_tokens.at(i++).to_float();
-				current_point += convert_svg_coord(x, y, false);
+				if( result.count() == 0 ){
+					//a relative moveto that starts the path is absolute
+					current_point = convert_svg_coord(x, y);
+				} else {
+					current_point += convert_svg_coord(x, y, false);
+				}
 				control_point = current_point;
 				move_point = current_point;
 				result.push_back(sgfx::Vector::get_path_move(current_point));
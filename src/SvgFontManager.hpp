@@ -7,6 +7,17 @@
 
 #include "FontObject.hpp"
 #include "BmpFontGenerator.hpp"
+#include "SvgPathLexer.hpp"
+#include "SvgReader.hpp"
+#include "CodePointSet.hpp"
+#include "RegionMap.hpp"
+#include "RowScanner.hpp"
+#include "RunTable.hpp"
+#include "DistanceMap.hpp"
+#include "ScratchPool.hpp"
+#include "ScanlineRasterizer.hpp"
+#include "PathGeometry.hpp"
+#include "WindingIndex.hpp"
 
 class FillPoint {
 public:
@@ -45,6 +56,34 @@ class SvgFontManager : public FontObject {
 public:
 	SvgFontManager();
 
+	enum fill {
+		FILL_POUR, //outline plus pour points found on the canvas
+		FILL_SCANLINE, //outline filled by winding rule (fonts only)
+		FILL_COVERAGE //area coverage sampled at the downsampled size (fonts only)
+	};
+
+	enum pour_select {
+		POUR_SELECT_DISTANCE, //point furthest from any edge
+		POUR_SELECT_SPACING //largest of the row gap and column spacing
+	};
+
+	enum pour_test {
+		POUR_TEST_RASTER, //inside by the order of the strokes on each row
+		POUR_TEST_WINDING //inside by the winding number of the path (fonts only)
+	};
+
+	/*! \details Why a glyph or icon was left out of the output. */
+	enum item_status {
+		ITEM_STATUS_OK,
+		ITEM_STATUS_INVALID, //file could not be read or has no svg, name or viewBox
+		ITEM_STATUS_MISSING_PATH, //no drawing path
+		ITEM_STATUS_PARSE_FAILED, //unexpected value or unhandled command in the path
+		ITEM_STATUS_OUT_OF_RANGE, //path points outside of the vector map
+		ITEM_STATUS_APPEND_FAILED //could not be added to the output
+	};
+
+	static const char * get_item_status_name(enum item_status value);
+
 	int process_font(
 			File::SourcePath source_file_path,
 			File::DestinationPath destination_directory_path
@@ -55,6 +94,21 @@ public:
 			File::DestinationPath destination_folder
 			);
 
+	/*! \details Moves the source of each icon that fails into \a path.
+	 *
+	 * Failed glyphs and icons are always left out of the output and
+	 * listed in the summary at the end of the run. With a quarantine
+	 * directory, the icon files are also moved out of the input folder
+	 * so the next run only sees the ones that convert.
+	 *
+	 */
+	void set_quarantine_path(const String & path){
+		m_quarantine_path = path;
+	}
+
+	/*! \details Returns the number of glyphs or icons left out of the last conversion. */
+	u32 failure_count() const { return m_failures.count(); }
+
 	void set_output_json(bool value = true ){
 		m_is_output_json = value;
 	}
@@ -74,13 +128,91 @@ public:
 
 	void set_pour_grid_size(u16 size){
 		m_pour_grid_size = size;
-		if( size == 0 ){ m_pour_grid_size = 8; }
+		if( size == 0 ){ m_pour_grid_size = POUR_GRID_DEFAULT; }
+	}
+
+	/*! \details Chooses the pour grid of each glyph from its outline.
+	 *
+	 * The regions of the outline are labeled from the runs of each
+	 * row before the search. The grid is the largest (up to
+	 * POUR_GRID_MAX) that still crosses the shortest enclosed region
+	 * on enough rows to give it a pour point. Heavy shapes are
+	 * searched on fewer rows and hairlines on more. The grid set with
+	 * set_pour_grid_size() is then only used to align glyph canvases.
+	 *
+	 */
+	void set_pour_grid_auto(bool value = true){
+		m_is_pour_grid_auto = value;
+	}
+
+	/*! \details Sets how far (in canvas pixels) flattened curves may be from the path.
+	 *
+	 * This applies to the scanline and coverage fills and to the
+	 * winding pour test. With zero (the default), it is a quarter of
+	 * an output pixel: the downsample factor times
+	 * PathGeometry::DEFAULT_TOLERANCE.
+	 *
+	 */
+	void set_flatness(float value){
+		m_flatness = value;
 	}
 
 	void set_downsample_factor(const Area & dim){
 		m_downsample = dim;
 	}
 
+	/*! \details Sets the number of threads used to rasterize glyphs and icons.
+	 *
+	 * The output is the same for any number of jobs.
+	 *
+	 */
+	void set_jobs(u32 jobs){
+		m_jobs = jobs ? jobs : 1;
+	}
+
+	/*! \details Sets how glyph outlines are filled.
+	 *
+	 * Icons are stored as vector paths and always use pour points.
+	 *
+	 */
+	void set_fill(enum fill value){
+		m_fill = value;
+	}
+
+	void set_fill_rule(enum ScanlineRasterizer::fill_rule value){
+		m_fill_rule = value;
+	}
+
+	/*! \details Sets how the pour point of each fill group is chosen. */
+	void set_pour_select(enum pour_select value){
+		m_pour_select = value;
+	}
+
+	/*! \details Finds pour points without per-pixel maps of the canvas.
+	 *
+	 * Regions are labeled from their runs only. The distance transform
+	 * is calculated just around each region that has candidates and is
+	 * skipped for everything else. The pour points are the same as
+	 * without this option.
+	 *
+	 */
+	void set_multires(bool value = true){
+		m_is_multires = value;
+	}
+
+	/*! \details Sets how candidates are found to be inside or outside of a glyph.
+	 *
+	 * With POUR_TEST_WINDING, each candidate is classified by its
+	 * winding number with the fill rule (see set_fill_rule()) so gaps
+	 * in the drawn outline do not change the result. Icons are
+	 * fitted to the canvas after they are drawn and always use the
+	 * raster test.
+	 *
+	 */
+	void set_pour_test(enum pour_test value){
+		m_pour_test = value;
+	}
+
 	void set_flip_y(bool value = true){
 		if( value ){
 			m_scale_sign_y = -1;
@@ -90,6 +222,8 @@ public:
 	}
 
 private:
+	friend class Benchmark;
+
 	enum {
 		NO_STATE,
 		MOVETO_STATE,
@@ -99,8 +233,43 @@ private:
 
 	enum {
 		PATH_DESCRIPTION_MAX = 256,
+		CANVAS_MARGIN = 2, //pixels around a glyph canvas
+		POUR_GRID_DEFAULT = 3,
+		POUR_GRID_MAX = 8,
+		POUR_GRID_ROWS = 3 //a group needs more than two candidates
 	};
 
+	typedef struct {
+		u8 ascii_value;
+		s32 x_advance;
+		String name;
+		String unicode;
+		String drawing_path; //copy of the path when rasterized later
+	} glyph_job_t;
+
+	typedef struct {
+		enum item_status status;
+		sg_font_char_t character;
+		Region active_region;
+		Bitmap active_canvas;
+		Bitmap bitmap;
+	} glyph_result_t;
+
+	typedef struct {
+		enum item_status status;
+		String name;
+		Region bounds; //viewBox
+		float scale; //svg units to vector space
+		float aspect_ratio;
+		var::Vector<sg_vector_path_description_t> elements;
+	} icon_result_t;
+
+	typedef struct {
+		String name;
+		String source; //icon file (empty for glyphs)
+		enum item_status status;
+	} item_failure_t;
+
 	BmpFontGenerator m_bmp_font_generator; //used for exporting to bmp
 	u16 m_canvas_size;
 	Area m_downsample;
@@ -118,34 +287,74 @@ private:
 	int m_scale_sign_y;
 	u16 m_point_size;
 	bool m_is_output_json;
-	var::Vector<sg_vector_path_description_t> m_vector_path_icon_list;
+	u32 m_jobs;
+	enum fill m_fill;
+	enum ScanlineRasterizer::fill_rule m_fill_rule;
+	enum pour_select m_pour_select;
+	bool m_is_multires;
+	bool m_is_pour_grid_auto;
+	float m_flatness;
+	enum pour_test m_pour_test;
+	var::Vector<glyph_job_t> m_glyph_jobs;
+	CodePointSet m_character_set_code_points;
+	CodePointSet m_loaded_code_points; //glyphs produced or queued
+	var::Vector<item_failure_t> m_failures;
+	CodePointSet m_failed_code_points;
+	String m_quarantine_path;
 	var::Vector<sg_font_char_t> m_font_character_list;
 
 
-	int process_svg_icon(const JsonObject & object);
+	int process_svg_icon(const String & view_box, const var::Vector<String> & drawing_paths, icon_result_t & icon);
+	int save_json(const String & input_file);
+	int convert_icon(const String & input_file, icon_result_t & icon);
+	int read_svg_icon(const String & input_file, String & name, String & view_box, var::Vector<String> & drawing_paths);
 	int parse_svg_path(const char * d);
 	static const String path_commands_sign(){ return "MmCcSsLlHhVvQqTtAaZz-"; }
 	static const String path_commands_space(){ return "MmCcSsLlHhVvQqTtAaZz \n\t"; }
 	static const String path_commands(){ return "MmCcSsLlHhVvQqTtAaZz"; }
 	static bool is_command_char(char c);
-	var::Vector<sg_vector_path_description_t> convert_svg_path(Bitmap & canvas, const var::String & d, const Area & canvas_dimensions, sg_size_t grid_size, bool is_fit_icon);
+	var::Vector<sg_vector_path_description_t> convert_svg_path(Bitmap & canvas, const char * d, u32 d_length, const Area & canvas_dimensions, sg_size_t grid_size, bool is_fit_icon, Point & canvas_offset, enum item_status * status = 0);
+	var::Vector<sg_vector_path_description_t> convert_svg_path(Bitmap & canvas, var::Vector<sg_vector_path_description_t> elements, const Area & canvas_dimensions, sg_size_t grid_size, bool is_fit_icon, Point & canvas_offset, float aspect_ratio);
+	float calculate_flatness() const;
+	u32 flatten_path(PathGeometry & geometry, const var::Vector<sg_vector_path_description_t> & elements, const Region & region);
+	static Region calculate_canvas_window(const Region & path_region, const Area & canvas_dimensions, sg_size_t grid_size);
 	var::Vector<sg_vector_path_description_t> process_svg_path(const String & path);
+	var::Vector<sg_vector_path_description_t> process_svg_path(const char * path, u32 length, enum item_status * status = 0);
+	var::Vector<sg_vector_path_description_t> process_svg_path(const char * path, u32 length, float scale, enum item_status * status);
+	var::Vector<sg_vector_path_description_t> process_svg_path_tokenized(const String & path);
+	int parse_svg_path_arguments(SvgPathLexer & lexer, char command, float * args);
 	Region parse_bounds(const String & value);
 	Area calculate_canvas_dimension(const Region & bounds, sg_size_t canvas_size);
 	Point calculate_canvas_origin(const Region & bounds, const Area & canvas_dimensions);
 	Point convert_svg_coord(float x, float y, bool is_absolute = true);
-	void fit_icon_to_canvas(Bitmap & bitmap, VectorPath & vector_path, const VectorMap & map);
-	static sg_size_t is_fill_point(const Bitmap & bitmap, sg_point_t point, const Region & region);
-	int process_glyph(const JsonObject & glyph);
-	int process_hkern(const JsonObject & kerning);
+	void fit_icon_to_canvas(Bitmap & bitmap, VectorPath & vector_path, const VectorMap & map, float aspect_ratio);
+	static sg_size_t is_fill_point(const RunTable & run_table, sg_point_t point, const Region & region);
+	static bool is_inside_runs(const RowScanner::run_t * first_run, const RowScanner::run_t * last_run, sg_int_t position, sg_int_t low, sg_int_t high, sg_size_t & spacing);
+	int process_font_face(const SvgReader::Element & font_face);
+	int process_glyph(const SvgReader::Element & glyph);
+	int load_glyph_job(const SvgReader::Element & glyph, glyph_job_t & job);
+	int rasterize_glyph(const glyph_job_t & job, const char * d, u32 d_length, glyph_result_t & result);
+	void commit_glyph(const glyph_job_t & job, const glyph_result_t & result);
+	void add_failure(const String & name, const String & source, enum item_status status);
+	int quarantine_icon(const String & source);
+	void print_summary(u32 converted_count);
+	int replace_file(const String & source, const String & destination);
+	int process_hkern(const SvgReader::Element & kerning);
 	sg_size_t map_svg_value_to_bitmap(u32 value);
 
 
 
-	var::Vector<Point> find_all_fill_points(const Bitmap & bitmap, const Region & region, sg_size_t grid);
+	var::Vector<Point> find_all_fill_points(const Bitmap & bitmap, const Region & region, sg_size_t grid, const WindingIndex * winding_index = 0);
+	static sg_size_t select_pour_grid_size(const RegionMap & region_map, sg_size_t & region_height);
+
+	void classify_fill_point_candidates(
+			const WindingIndex & winding_index,
+			var::Vector<FillPoint> & fill_points,
+			var::Vector<FillPoint> & negative_fill_points
+			);
 
 	var::Vector<FillPoint> find_fill_point_candidates(
-			const Bitmap & bitmap,
+			const RunTable & run_table,
 			const Region & region,
 			sg_size_t grid_size,
 			bool is_negative_fill
@@ -158,18 +367,17 @@ private:
 			);
 
 	var::Vector<var::Vector<FillPoint>> group_fill_point_candidates(
-			const Bitmap & bitmap,
+			const RegionMap & region_map,
 			var::Vector<FillPoint> & fill_points);
 
-	var::Vector<Point> find_final_fill_points(const Bitmap & bitmap,
+	var::Vector<Point> find_final_fill_points(
+			const RunTable & run_table,
+			const RegionMap & region_map,
+			DistanceMap & distance_map,
 			var::Vector<var::Vector<FillPoint> > & fill_point_groups,
 			const var::Vector<var::Vector<FillPoint> > & negative_fill_point_groups
 			);
 
-	sg_size_t get_y_fill_spacing(
-			const Bitmap & bitmap,
-			Point point
-			);
 
 
 };
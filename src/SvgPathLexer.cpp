@@ -0,0 +1,170 @@
+/*! \file */ //Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+#include "SvgPathLexer.hpp"
+
+namespace {
+
+enum {
+	CLASS_COMMAND = 0x01,
+	CLASS_SEPARATOR = 0x02,
+	CLASS_SIGN = 0x04,
+	CLASS_DIGIT = 0x08,
+	CLASS_DOT = 0x10,
+	CLASS_EXPONENT = 0x20
+};
+
+struct CharacterClassTable {
+	constexpr CharacterClassTable() : value() {
+		const char commands[] = "MmCcSsLlHhVvQqTtAaZz";
+		for(u32 i=0; i < sizeof(commands)-1; i++){
+			value[(u8)commands[i]] = CLASS_COMMAND;
+		}
+		value[(u8)' '] = CLASS_SEPARATOR;
+		value[(u8)','] = CLASS_SEPARATOR;
+		value[(u8)'\t'] = CLASS_SEPARATOR;
+		value[(u8)'\n'] = CLASS_SEPARATOR;
+		value[(u8)'\r'] = CLASS_SEPARATOR;
+		value[(u8)'\f'] = CLASS_SEPARATOR;
+		value[(u8)'-'] = CLASS_SIGN;
+		value[(u8)'+'] = CLASS_SIGN;
+		for(u32 i='0'; i <= '9'; i++){
+			value[i] = CLASS_DIGIT;
+		}
+		value[(u8)'.'] = CLASS_DOT;
+		value[(u8)'e'] = CLASS_EXPONENT;
+		value[(u8)'E'] = CLASS_EXPONENT;
+	}
+	u8 value[256];
+};
+
+constexpr CharacterClassTable character_class_table;
+
+inline u8 character_class(char c){
+	return character_class_table.value[(u8)c];
+}
+
+//exact powers of ten -- larger exponents don't show up in path data
+const double power_of_ten[] = {
+	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+	1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20,
+	1e21, 1e22
+};
+
+}
+
+bool SvgPathLexer::is_command(char c){
+	return character_class(c) == CLASS_COMMAND;
+}
+
+void SvgPathLexer::skip_separators(){
+	while( (m_cursor < m_end) && (character_class(*m_cursor) == CLASS_SEPARATOR) ){
+		m_cursor++;
+	}
+}
+
+bool SvgPathLexer::is_end(){
+	skip_separators();
+	return m_cursor == m_end;
+}
+
+bool SvgPathLexer::parse_command(char & command){
+	skip_separators();
+	if( (m_cursor < m_end) && (character_class(*m_cursor) == CLASS_COMMAND) ){
+		command = *m_cursor++;
+		return true;
+	}
+	return false;
+}
+
+bool SvgPathLexer::parse_flag(bool & value){
+	skip_separators();
+	if( (m_cursor < m_end) && (*m_cursor == '0' || *m_cursor == '1') ){
+		value = *m_cursor++ == '1';
+		return true;
+	}
+	return false;
+}
+
+bool SvgPathLexer::parse_number(float & value){
+	skip_separators();
+
+	const char * p = m_cursor;
+	bool is_negative = false;
+	u64 mantissa = 0;
+	int exponent = 0;
+	int digit_count = 0;
+
+	if( (p < m_end) && (character_class(*p) == CLASS_SIGN) ){
+		is_negative = *p == '-';
+		p++;
+	}
+
+	while( (p < m_end) && (character_class(*p) == CLASS_DIGIT) ){
+		if( mantissa < 100000000000000000ULL ){
+			mantissa = mantissa*10 + (*p - '0');
+		} else {
+			exponent++;
+		}
+		digit_count++;
+		p++;
+	}
+
+	//a second '.' starts the next number: 1.5.5 is 1.5 then 0.5
+	if( (p < m_end) && (character_class(*p) == CLASS_DOT) ){
+		p++;
+		while( (p < m_end) && (character_class(*p) == CLASS_DIGIT) ){
+			if( mantissa < 100000000000000000ULL ){
+				mantissa = mantissa*10 + (*p - '0');
+				exponent--;
+			}
+			digit_count++;
+			p++;
+		}
+	}
+
+	if( digit_count == 0 ){
+		return false;
+	}
+
+	//only consume an exponent if digits follow it
+	if( (p < m_end) && (character_class(*p) == CLASS_EXPONENT) ){
+		const char * e = p + 1;
+		bool is_exponent_negative = false;
+		if( (e < m_end) && (character_class(*e) == CLASS_SIGN) ){
+			is_exponent_negative = *e == '-';
+			e++;
+		}
+
+		if( (e < m_end) && (character_class(*e) == CLASS_DIGIT) ){
+			int explicit_exponent = 0;
+			while( (e < m_end) && (character_class(*e) == CLASS_DIGIT) ){
+				if( explicit_exponent < 1000 ){
+					explicit_exponent = explicit_exponent*10 + (*e - '0');
+				}
+				e++;
+			}
+			exponent += is_exponent_negative ? -explicit_exponent : explicit_exponent;
+			p = e;
+		}
+	}
+
+	double result = mantissa;
+	while( exponent > 22 ){
+		result *= power_of_ten[22];
+		exponent -= 22;
+	}
+	while( exponent < -22 ){
+		result /= power_of_ten[22];
+		exponent += 22;
+	}
+
+	if( exponent > 0 ){
+		result *= power_of_ten[exponent];
+	} else if( exponent < 0 ){
+		result /= power_of_ten[-exponent];
+	}
+
+	value = is_negative ? -result : result;
+	m_cursor = p;
+	return true;
+}
@@ -0,0 +1,63 @@
+/*! \file */ //Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+
+#ifndef SVGPATHLEXER_HPP_
+#define SVGPATHLEXER_HPP_
+
+#include <sapi/var.hpp>
+
+/*! \details Walks SVG path data (the `d` attribute) in place.
+ *
+ * The lexer never copies the input. Commands and separators are
+ * classified using a constexpr lookup table and numbers are
+ * parsed directly from the buffer. This handles the compact forms
+ * that font converters emit such as `M10-20`, `1.5.5` (two numbers)
+ * and `1e-3`.
+ *
+ */
+class SvgPathLexer {
+public:
+	SvgPathLexer(const char * path, u32 length){
+		m_begin = path;
+		m_cursor = path;
+		m_end = path + length;
+	}
+
+	/*! \details Skips separators and returns true if no data remains. */
+	bool is_end();
+
+	/*! \details Consumes a command character if one is next.
+	 *
+	 * Returns false (without consuming anything) if the next
+	 * token is not a command.
+	 *
+	 */
+	bool parse_command(char & command);
+
+	/*! \details Parses the next number.
+	 *
+	 * Returns false (without consuming anything) if the next
+	 * token is not a number.
+	 *
+	 */
+	bool parse_number(float & value);
+
+	/*! \details Parses an arc flag which may be written without
+	 * a separator before the next value (`a1 1 0 011 1`).
+	 */
+	bool parse_flag(bool & value);
+
+	/*! \details Returns the offset of the cursor from the start of the data. */
+	u32 offset() const { return m_cursor - m_begin; }
+
+	static bool is_command(char c);
+
+private:
+	void skip_separators();
+
+	const char * m_begin;
+	const char * m_cursor;
+	const char * m_end;
+};
+
+#endif /* SVGPATHLEXER_HPP_ */
@@ -0,0 +1,397 @@
+/*! \file */ //Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+#include <cstring>
+#include <cstdlib>
+#include "SvgReader.hpp"
+
+namespace {
+
+inline bool is_space(char c){
+	return (c == ' ') || (c == '\t') || (c == '\n') || (c == '\r');
+}
+
+void append_utf8(var::String & result, u32 code_point){
+	if( code_point < 0x80 ){
+		result << (char)code_point;
+	} else if( code_point < 0x800 ){
+		result << (char)(0xC0 | (code_point >> 6));
+		result << (char)(0x80 | (code_point & 0x3F));
+	} else if( code_point < 0x10000 ){
+		result << (char)(0xE0 | (code_point >> 12));
+		result << (char)(0x80 | ((code_point >> 6) & 0x3F));
+		result << (char)(0x80 | (code_point & 0x3F));
+	} else {
+		result << (char)(0xF0 | (code_point >> 18));
+		result << (char)(0x80 | ((code_point >> 12) & 0x3F));
+		result << (char)(0x80 | ((code_point >> 6) & 0x3F));
+		result << (char)(0x80 | (code_point & 0x3F));
+	}
+}
+
+bool parse_character_reference(const char * entity, u32 length, u32 & code_point){
+	code_point = 0;
+	if( (length > 1) && (entity[0] == '#') ){
+		u32 base = 10;
+		u32 i = 1;
+		if( (entity[1] == 'x') || (entity[1] == 'X') ){
+			base = 16;
+			i = 2;
+		}
+
+		if( i == length ){
+			return false;
+		}
+
+		for(; i < length; i++){
+			char c = entity[i];
+			u32 digit;
+			if( (c >= '0') && (c <= '9') ){
+				digit = c - '0';
+			} else if( (base == 16) && (c >= 'a') && (c <= 'f') ){
+				digit = c - 'a' + 10;
+			} else if( (base == 16) && (c >= 'A') && (c <= 'F') ){
+				digit = c - 'A' + 10;
+			} else {
+				return false;
+			}
+			code_point = code_point * base + digit;
+			if( code_point > 0x10FFFF ){
+				return false;
+			}
+		}
+		return true;
+	}
+
+	struct named_entity_t {
+		const char * name;
+		char value;
+	};
+
+	const named_entity_t named_entities[] = {
+		{ "amp", '&' },
+		{ "lt", '<' },
+		{ "gt", '>' },
+		{ "quot", '"' },
+		{ "apos", '\'' }
+	};
+
+	for(const auto & named_entity: named_entities){
+		if( (strlen(named_entity.name) == length) &&
+			 (memcmp(named_entity.name, entity, length) == 0) ){
+			code_point = named_entity.value;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+}
+
+bool SvgReader::Element::is_name(const char * name) const {
+	u32 length = strlen(name);
+	return (length == m_name_length) &&
+			(memcmp(m_name, name, length) == 0);
+}
+
+var::String SvgReader::Element::name() const {
+	return decode(m_name, m_name_length);
+}
+
+bool SvgReader::Element::find_attribute(
+		const char * name,
+		const char *& value,
+		u32 & length
+		) const {
+	const char * p = m_attributes;
+	const char * end = m_attributes + m_attributes_length;
+	u32 name_length = strlen(name);
+
+	while( p < end ){
+		while( (p < end) && is_space(*p) ){ p++; }
+
+		const char * attribute_name = p;
+		while( (p < end) && !is_space(*p) && (*p != '=') ){ p++; }
+		u32 attribute_name_length = p - attribute_name;
+
+		while( (p < end) && is_space(*p) ){ p++; }
+		if( (p == end) || (*p != '=') ){
+			//malformed attribute
+			return false;
+		}
+		p++;
+
+		while( (p < end) && is_space(*p) ){ p++; }
+		if( (p == end) || ((*p != '"') && (*p != '\'')) ){
+			return false;
+		}
+
+		char quote = *p++;
+		const char * attribute_value = p;
+		while( (p < end) && (*p != quote) ){ p++; }
+
+		if( (attribute_name_length == name_length) &&
+			 (memcmp(attribute_name, name, name_length) == 0) ){
+			value = attribute_value;
+			length = p - attribute_value;
+			return true;
+		}
+
+		p++;
+	}
+
+	return false;
+}
+
+var::String SvgReader::Element::attribute(const char * name) const {
+	const char * value;
+	u32 length;
+	if( find_attribute(name, value, length) ){
+		return decode(value, length);
+	}
+	return var::String();
+}
+
+var::String SvgReader::Element::decode(const char * value, u32 length){
+	var::String result;
+	const char * end = value + length;
+
+	while( value < end ){
+		char c = *value++;
+		const char * semicolon;
+		u32 code_point;
+
+		if( (c == '&') &&
+			 ((semicolon = (const char*)memchr(value, ';', end - value)) != 0) &&
+			 parse_character_reference(value, semicolon - value, code_point) ){
+			append_utf8(result, code_point);
+			value = semicolon + 1;
+		} else {
+			result << c;
+		}
+	}
+
+	return result;
+}
+
+SvgReader::SvgReader(){
+	m_file = 0;
+	m_buffer = 0;
+	m_window = 0;
+	m_buffer_size = 0;
+	m_start = 0;
+	m_end = 0;
+}
+
+SvgReader::~SvgReader(){
+	close();
+}
+
+int SvgReader::open(const var::String & path){
+	close();
+	if( m_input.map(path) == 0 ){
+		//the whole file is in the window so fill() is never needed
+		m_window = m_input.text();
+		m_end = m_input.size();
+		return 0;
+	}
+
+	m_file = fopen(path.cstring(), "rb");
+	if( m_file == 0 ){
+		printer().error("failed to open %s", path.cstring());
+		return -1;
+	}
+
+	m_buffer_size = INITIAL_BUFFER_SIZE;
+	m_buffer = (char*)malloc(m_buffer_size);
+	if( m_buffer == 0 ){
+		close();
+		return -1;
+	}
+	m_window = m_buffer;
+	return 0;
+}
+
+void SvgReader::close(){
+	if( m_file ){
+		fclose(m_file);
+		m_file = 0;
+	}
+
+	m_input.close();
+	free(m_buffer);
+	m_buffer = 0;
+	m_window = 0;
+	m_buffer_size = 0;
+	m_start = 0;
+	m_end = 0;
+}
+
+bool SvgReader::fill(){
+	if( m_file == 0 ){
+		return false;
+	}
+
+	//offsets relative to m_start stay valid after the window moves
+	if( m_start > 0 ){
+		memmove(m_buffer, m_buffer + m_start, m_end - m_start);
+		m_end -= m_start;
+		m_start = 0;
+	}
+
+	if( m_end == m_buffer_size ){
+		char * buffer = (char*)realloc(m_buffer, m_buffer_size*2);
+		if( buffer == 0 ){
+			printer().error("failed to grow svg read buffer");
+			return false;
+		}
+		m_buffer = buffer;
+		m_window = buffer;
+		m_buffer_size *= 2;
+	}
+
+	size_t bytes_read = fread(
+				m_buffer + m_end,
+				1,
+				m_buffer_size - m_end,
+				m_file
+				);
+
+	if( bytes_read == 0 ){
+		return false;
+	}
+
+	m_end += bytes_read;
+	return true;
+}
+
+bool SvgReader::find(const char * pattern, u32 & offset){
+	u32 pattern_length = strlen(pattern);
+	do {
+		const char * window = m_window + m_start;
+		u32 available = m_end - m_start;
+		while( offset + pattern_length <= available ){
+			const char * match = (const char*)memchr(
+						window + offset,
+						pattern[0],
+						available - offset
+						);
+
+			if( match == 0 ){
+				offset = available;
+				break;
+			}
+
+			offset = match - window;
+			if( offset + pattern_length > available ){
+				break;
+			}
+
+			if( memcmp(match, pattern, pattern_length) == 0 ){
+				return true;
+			}
+			offset++;
+		}
+	} while( fill() );
+
+	return false;
+}
+
+bool SvgReader::find_tag_end(u32 & offset){
+	char quote = 0;
+	do {
+		const char * window = m_window + m_start;
+		u32 available = m_end - m_start;
+		for(; offset < available; offset++){
+			char c = window[offset];
+			if( quote ){
+				if( c == quote ){ quote = 0; }
+			} else if( (c == '"') || (c == '\'') ){
+				quote = c;
+			} else if( c == '>' ){
+				return true;
+			}
+		}
+	} while( fill() );
+
+	return false;
+}
+
+bool SvgReader::next(Element & element){
+	while( 1 ){
+		u32 offset = 0;
+		if( find("<", offset) == false ){
+			m_start = m_end;
+			return false;
+		}
+		m_start += offset;
+
+		while( (m_end - m_start < 4) && fill() ){}
+		u32 available = m_end - m_start;
+		const char * tag = m_window + m_start;
+
+		const char * terminator = 0;
+		if( (available >= 4) && (memcmp(tag, "<!--", 4) == 0) ){
+			offset = 4;
+			terminator = "-->";
+		} else if( (available >= 2) && (tag[1] == '?') ){
+			offset = 2;
+			terminator = "?>";
+		} else if( (available >= 2) && (tag[1] == '!') ){
+			offset = 2;
+			terminator = ">";
+		}
+
+		if( terminator ){
+			if( find(terminator, offset) == false ){
+				m_start = m_end;
+				return false;
+			}
+			m_start += offset + strlen(terminator);
+			continue;
+		}
+
+		offset = 1;
+		if( find_tag_end(offset) == false ){
+			m_start = m_end;
+			return false;
+		}
+
+		//the window may have moved while looking for the end of the tag
+		tag = m_window + m_start;
+		const char * p = tag + 1;
+		const char * end = tag + offset;
+
+		element.m_is_closing = false;
+		element.m_is_empty = false;
+		if( (p < end) && (*p == '/') ){
+			element.m_is_closing = true;
+			p++;
+		}
+
+		if( (end > p) && (*(end-1) == '/') ){
+			element.m_is_empty = true;
+			end--;
+		}
+
+		element.m_name = p;
+		while( (p < end) && !is_space(*p) ){ p++; }
+		element.m_name_length = p - element.m_name;
+		element.m_attributes = p;
+		element.m_attributes_length = end - p;
+
+		m_start += offset + 1;
+		return true;
+	}
+}
+
+var::String SvgReader::read_text(){
+	u32 offset = 0;
+	if( find("<", offset) == false ){
+		offset = m_end - m_start;
+	}
+
+	var::String result = Element::decode(m_window + m_start, offset);
+	m_start += offset;
+	return result;
+}
@@ -0,0 +1,126 @@
+/*! \file */ //Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+
+#ifndef SVGREADER_HPP_
+#define SVGREADER_HPP_
+
+#include <cstdio>
+#include <sapi/var.hpp>
+#include <sapi/fs.hpp>
+#include "ApplicationPrinter.hpp"
+#include "InputFile.hpp"
+
+/*! \details Event-driven reader for SVG (XML) files.
+ *
+ * The reader streams the file through a small window and returns
+ * one tag at a time. Attributes are not parsed until they are
+ * requested so elements that are not needed (such as glyphs outside
+ * of the character set) can be skipped cheaply. Memory use is bounded
+ * by the largest single tag rather than the file size. On the desktop
+ * build the file is memory mapped and the window is the whole file.
+ *
+ * ```
+ * SvgReader reader;
+ * SvgReader::Element element;
+ * reader.open(path);
+ * while( reader.next(element) ){
+ *   if( element.is_name("glyph") ){
+ *     String unicode = element.attribute("unicode");
+ *   }
+ * }
+ * ```
+ *
+ */
+class SvgReader : public ApplicationPrinter {
+public:
+
+	class Element {
+	public:
+		Element(){
+			m_name = 0;
+			m_name_length = 0;
+			m_attributes = 0;
+			m_attributes_length = 0;
+			m_is_closing = false;
+			m_is_empty = false;
+		}
+
+		bool is_name(const char * name) const;
+		var::String name() const;
+
+		/*! \details Returns true for closing tags such as `</font>`. */
+		bool is_closing() const { return m_is_closing; }
+
+		/*! \details Returns true for self-closing tags such as `<glyph ... />`. */
+		bool is_empty() const { return m_is_empty; }
+
+		/*! \details Finds the raw (undecoded) value of an attribute.
+		 *
+		 * The value points into the reader's window and is only valid
+		 * until the next call to SvgReader::next().
+		 *
+		 */
+		bool find_attribute(const char * name, const char *& value, u32 & length) const;
+
+		/*! \details Returns the value of an attribute with
+		 * character references (`&#x22;`, `&amp;`) decoded.
+		 *
+		 * An empty string is returned if the attribute is not present.
+		 *
+		 */
+		var::String attribute(const char * name) const;
+
+		static var::String decode(const char * value, u32 length);
+
+	private:
+		friend class SvgReader;
+		const char * m_name;
+		u32 m_name_length;
+		const char * m_attributes;
+		u32 m_attributes_length;
+		bool m_is_closing;
+		bool m_is_empty;
+	};
+
+	SvgReader();
+	~SvgReader();
+
+	int open(const var::String & path);
+	void close();
+
+	/*! \details Reads the next start or end tag.
+	 *
+	 * Comments, processing instructions, declarations and text
+	 * are skipped. Returns false at the end of the file.
+	 *
+	 */
+	bool next(Element & element);
+
+	/*! \details Reads the text that follows the most recent tag. */
+	var::String read_text();
+
+	/*! \details Returns the size of the largest window used so far. */
+	u32 buffer_size() const { return m_buffer_size; }
+
+	/*! \details Returns true if the file is memory mapped. */
+	bool is_mapped() const { return m_input.is_mapped(); }
+
+private:
+	enum {
+		INITIAL_BUFFER_SIZE = 4096
+	};
+
+	InputFile m_input;
+	FILE * m_file;
+	char * m_buffer;
+	const char * m_window;
+	u32 m_buffer_size;
+	u32 m_start;
+	u32 m_end;
+
+	bool fill();
+	bool find(const char * pattern, u32 & offset);
+	bool find_tag_end(u32 & offset);
+};
+
+#endif /* SVGREADER_HPP_ */
@@ -4,6 +4,12 @@
 #include <sapi/fmt.hpp>
 #include <sapi/fs.hpp>
 #include "Util.hpp"
+#include "InputFile.hpp"
+
+#if defined __link && (defined __linux__ || defined __APPLE__)
+#include <sys/resource.h>
+#define HAS_RUSAGE 1
+#endif
 
 void Util::filter(
 		Bitmap & bitmap
@@ -194,12 +200,9 @@ void Util::show_file_font(
 	show_font(ff);
 
 	if( is_details.argument() ){
-		File f;
+		InputFile f;
 
-		if( f.open(
-				 input_file.argument(),
-				 OpenFlags::read_only()
-				 ) < 0 ){
+		if( f.open(input_file.argument()) < 0 ){
 			Ap::printer().error(
 						"Failed to open file '%s'",
 						input_file.argument().cstring()
@@ -207,11 +210,14 @@ void Util::show_file_font(
 			return;
 		}
 
+		//records are read in place from the mapped file
+		u32 offset = 0;
 		sg_font_header_t header;
-		if( f.read(header) != sizeof(sg_font_header_t) ){
+		if( f.read(offset, header) != sizeof(sg_font_header_t) ){
 			Ap::printer().error("failed to read header");
 			return;
 		}
+		offset += sizeof(sg_font_header_t);
 
 		printer().open_object("header");
 		{
@@ -231,10 +237,11 @@ void Util::show_file_font(
 		Vector<sg_font_kerning_pair_t> kerning_pairs;
 		for(u32 i=0; i < header.kerning_pair_count; i++){
 			sg_font_kerning_pair_t pair;
-			if( f.read(pair) != sizeof(sg_font_kerning_pair_t) ){
+			if( f.read(offset, pair) != sizeof(sg_font_kerning_pair_t) ){
 				Ap::printer().error("Failed to read kerning pair");
 				return;
 			}
+			offset += sizeof(sg_font_kerning_pair_t);
 			kerning_pairs.push_back(pair);
 		}
 
@@ -255,16 +262,17 @@ void Util::show_file_font(
 		Vector<sg_font_char_t> characters;
 		for(u32 i=0; i < header.character_count; i++){
 			sg_font_char_t character;
-			printer().debug("read character from %d", f.seek(0, File::CURRENT));
-			if( f.read(character) != sizeof(sg_font_char_t) ){
+			printer().debug("read character from %d", offset);
+			if( f.read(offset, character) != sizeof(sg_font_char_t) ){
 				Ap::printer().error(
-							"Failed to read character at %d (%d, %d)",
+							"Failed to read character at %d (offset %d of %d)",
 							i,
-							f.return_value(),
-							f.error_number()
+							offset,
+							f.size()
 							);
-				continue;
+				break;
 			}
+			offset += sizeof(sg_font_char_t);
 			printer().debug("push character %d", character.id);
 			characters.push_back(character);
 		}
@@ -372,3 +380,20 @@ void Util::show_system_font(int idx){
 	printf("Not implemented\n");
 #endif
 }
+
+u32 Util::get_peak_memory_usage(){
+#if defined HAS_RUSAGE
+	struct rusage usage;
+	if( getrusage(RUSAGE_SELF, &usage) < 0 ){
+		return 0;
+	}
+#if defined __APPLE__
+	return usage.ru_maxrss;
+#else
+	//linux reports kilobytes
+	return usage.ru_maxrss * 1024;
+#endif
+#else
+	return 0;
+#endif
+}
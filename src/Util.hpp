@@ -33,6 +33,11 @@ public:
 	static void show_system_font(int idx);
 	static void clean_path(const String & path, const String & suffix);
 
+	/*! \details Returns the peak resident memory of the process in bytes
+	 * (or zero if it is not available on the platform).
+	 */
+	static u32 get_peak_memory_usage();
+
 
 private:
 	static void filter(Bitmap & bitmap);
@@ -0,0 +1,99 @@
+/*! \file */ //Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+#include <algorithm>
+#include <cmath>
+#include "WindingIndex.hpp"
+
+WindingIndex::WindingIndex(
+		const PathGeometry & geometry,
+		sg_size_t height,
+		enum ScanlineRasterizer::fill_rule rule
+		){
+	m_fill_rule = rule;
+	m_row_start.resize(height + 1);
+	for(auto & start: m_row_start){
+		start = 0;
+	}
+
+	//rows sampled by a segment -- y_top <= center < y_bottom like the fill
+	auto get_rows = [height](const PathGeometry::segment_t & segment, int & first, int & last){
+		float y_top = segment.y0 < segment.y1 ? segment.y0 : segment.y1;
+		float y_bottom = segment.y0 < segment.y1 ? segment.y1 : segment.y0;
+		first = (int)ceilf(y_top - 0.5f);
+		last = (int)ceilf(y_bottom - 0.5f);
+		if( first < 0 ){ first = 0; }
+		if( last > (int)height ){ last = height; }
+	};
+
+	//count the crossings of each row then place them
+	int first, last;
+	for(const auto & segment: geometry.segments()){
+		get_rows(segment, first, last);
+		for(int y = first; y < last; y++){
+			m_row_start.at(y+1)++;
+		}
+	}
+
+	for(u32 y = 0; y < height; y++){
+		m_row_start.at(y+1) += m_row_start.at(y);
+	}
+
+	m_crossings.resize(m_row_start.at(height));
+	var::Vector<u32> next;
+	next.resize(height);
+	for(u32 y = 0; y < height; y++){
+		next.at(y) = m_row_start.at(y);
+	}
+
+	for(const auto & segment: geometry.segments()){
+		get_rows(segment, first, last);
+		//the same arithmetic as the fill so the results match exactly
+		const bool is_down = segment.y0 < segment.y1;
+		const float x_top = is_down ? segment.x0 : segment.x1;
+		const float y_top = is_down ? segment.y0 : segment.y1;
+		const float slope = (segment.x1 - segment.x0) / (segment.y1 - segment.y0);
+		for(int y = first; y < last; y++){
+			crossing_t & crossing = m_crossings.at(next.at(y)++);
+			crossing.x = x_top + (y + 0.5f - y_top) * slope;
+			crossing.winding = is_down ? 1 : -1;
+		}
+	}
+
+	//sort each row and accumulate the winding from the left
+	for(u32 y = 0; y < height; y++){
+		crossing_t * begin = m_crossings.data() + m_row_start.at(y);
+		crossing_t * end = m_crossings.data() + m_row_start.at(y+1);
+		std::sort(begin, end, [](const crossing_t & a, const crossing_t & b){
+			return a.x < b.x;
+		});
+
+		s16 winding = 0;
+		for(crossing_t * crossing = begin; crossing < end; crossing++){
+			winding += crossing->winding;
+			crossing->winding = winding;
+		}
+	}
+}
+
+int WindingIndex::winding(const sgfx::Point & point) const {
+	if( (point.y() < 0) || ((u32)point.y() + 1 >= m_row_start.count()) ){
+		return 0;
+	}
+
+	//the fill sets a pixel when its center is at or past a crossing
+	const float x_center = point.x() + 0.5f;
+	const crossing_t * begin = m_crossings.data() + m_row_start.at(point.y());
+	const crossing_t * end = m_crossings.data() + m_row_start.at(point.y() + 1);
+	const crossing_t * after = std::upper_bound(
+				begin,
+				end,
+				x_center,
+				[](float x, const crossing_t & crossing){
+		return x < crossing.x;
+	});
+
+	if( after == begin ){
+		return 0;
+	}
+	return (after-1)->winding;
+}
@@ -0,0 +1,65 @@
+/*! \file */ //Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+
+#ifndef WINDINGINDEX_HPP_
+#define WINDINGINDEX_HPP_
+
+#include <vector>
+#include <sapi/var.hpp>
+#include <sapi/sgfx.hpp>
+#include "PathGeometry.hpp"
+#include "ScanlineRasterizer.hpp"
+
+/*! \details Answers "is this pixel inside the path" from the path itself.
+ *
+ * The segments of a flattened path are bucketed by the pixel rows
+ * they cross. Each row keeps its crossings (at the pixel centers)
+ * sorted by x along with the running winding number, so the winding
+ * number of any pixel is one binary search of its row. No pixels are
+ * walked and the answer does not depend on how the outline was drawn.
+ *
+ * A pixel is inside exactly when ScanlineRasterizer::fill() would set
+ * it with the same fill rule.
+ *
+ * ```
+ * PathGeometry geometry;
+ * geometry.flatten(elements, canvas.get_viewable_region());
+ * WindingIndex index(geometry, canvas.height());
+ * bool is_inside = index.is_inside(Point(10,20));
+ * ```
+ *
+ */
+class WindingIndex {
+public:
+
+	WindingIndex(
+			const PathGeometry & geometry,
+			sg_size_t height,
+			enum ScanlineRasterizer::fill_rule rule = ScanlineRasterizer::FILL_RULE_NONZERO
+			);
+
+	/*! \details Returns the winding number at the center of the pixel at \a point. */
+	int winding(const sgfx::Point & point) const;
+
+	bool is_inside(const sgfx::Point & point) const {
+		int value = winding(point);
+		return m_fill_rule == ScanlineRasterizer::FILL_RULE_NONZERO ?
+					value != 0 :
+					(value & 0x01) != 0;
+	}
+
+	/*! \details Returns the number of row crossings in the index. */
+	u32 crossing_count() const { return m_crossings.size(); }
+
+private:
+	typedef struct {
+		float x;
+		s16 winding; //winding number to the right of x
+	} crossing_t;
+
+	enum ScanlineRasterizer::fill_rule m_fill_rule;
+	var::Vector<u32> m_row_start; //first crossing of each row (one extra entry)
+	std::vector<crossing_t> m_crossings; //rows are sorted in place
+};
+
+#endif /* WINDINGINDEX_HPP_ */
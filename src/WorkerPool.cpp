@@ -0,0 +1,99 @@
+/*! \file */ //Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+#include "WorkerPool.hpp"
+
+#if defined __link
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#define HAS_THREADS 1
+#endif
+
+WorkerPool::WorkerPool(u32 jobs){
+	m_jobs = jobs ? jobs : 1;
+#if !defined HAS_THREADS
+	m_jobs = 1;
+#endif
+}
+
+u32 WorkerPool::get_hardware_concurrency(){
+#if defined HAS_THREADS
+	u32 result = std::thread::hardware_concurrency();
+	return result ? result : 1;
+#else
+	return 1;
+#endif
+}
+
+int WorkerPool::run(
+		u32 count,
+		const std::function<void(u32)> & task,
+		const std::function<bool(u32)> & commit
+		){
+
+	if( (m_jobs == 1) || (count < 2) ){
+		for(u32 i=0; i < count; i++){
+			task(i);
+			if( commit(i) == false ){
+				return -1;
+			}
+		}
+		return 0;
+	}
+
+#if defined HAS_THREADS
+	std::atomic<u32> next(0);
+	std::mutex mutex;
+	std::condition_variable condition;
+	std::vector<bool> is_done(count, false);
+	std::vector<std::thread> threads;
+	u32 thread_count = m_jobs < count ? m_jobs : count;
+
+	//warnings explain why an item fails so they are kept (unless the
+	//calling thread hides them too)
+	const char * worker_level =
+			printer().verbose_level() >= Printer::WARNING ? "warning" : "error";
+
+	for(u32 t=0; t < thread_count; t++){
+		threads.push_back(std::thread([&](){
+			YamlPrinter worker_printer;
+			worker_printer.set_verbose_level(worker_level);
+			set_thread_printer(&worker_printer);
+
+			u32 i;
+			while( (i = next++) < count ){
+				task(i);
+				std::lock_guard<std::mutex> lock(mutex);
+				is_done[i] = true;
+				condition.notify_all();
+			}
+
+			set_thread_printer(0);
+		}));
+	}
+
+	//commit in index order as soon as each item is ready
+	int result = 0;
+	for(u32 i=0; i < count; i++){
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			condition.wait(lock, [&](){ return is_done[i]; });
+		}
+		if( commit(i) == false ){
+			//items that are already running are allowed to finish
+			next = count;
+			result = -1;
+			break;
+		}
+	}
+
+	for(auto & thread: threads){
+		thread.join();
+	}
+	return result;
+#else
+	return 0;
+#endif
+}
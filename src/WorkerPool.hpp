@@ -0,0 +1,56 @@
+/*! \file */ //Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+
+#ifndef WORKERPOOL_HPP_
+#define WORKERPOOL_HPP_
+
+#include <functional>
+#include <sapi/var.hpp>
+#include "ApplicationPrinter.hpp"
+
+/*! \details Runs independent work items on a set of threads.
+ *
+ * Items are executed in any order but the results are committed on
+ * the calling thread in index order so the output is the same as a
+ * serial run. If a commit returns false, no more items are started
+ * and run() returns -1.
+ *
+ * While a worker thread is running a task, printer() only reports
+ * warnings and errors so the log of the calling thread is not
+ * interleaved with per-item messages but the cause of a failed item
+ * is still shown.
+ *
+ * Threads are only available on the desktop (link) build. Elsewhere,
+ * or when the pool has a single job, each task is followed directly
+ * by its commit on the calling thread.
+ *
+ * ```
+ * WorkerPool pool(4);
+ * pool.run(
+ *   items.count(),
+ *   [&](u32 i){ results.at(i) = process(items.at(i)); },
+ *   [&](u32 i){ return save(results.at(i)) == 0; }
+ * );
+ * ```
+ *
+ */
+class WorkerPool : public ApplicationPrinter {
+public:
+	explicit WorkerPool(u32 jobs = 1);
+
+	u32 jobs() const { return m_jobs; }
+
+	int run(
+			u32 count,
+			const std::function<void(u32)> & task,
+			const std::function<bool(u32)> & commit
+			);
+
+	/*! \details Returns the number of hardware threads (at least 1). */
+	static u32 get_hardware_concurrency();
+
+private:
+	u32 m_jobs;
+};
+
+#endif /* WORKERPOOL_HPP_ */
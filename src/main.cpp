@@ -7,6 +7,7 @@
 #include <sapi/sgfx.hpp>
 
 #include "Util.hpp"
+#include "Benchmark.hpp"
 #include "BmpFontManager.hpp"
 #include "SvgFontManager.hpp"
 #include "ApplicationPrinter.hpp"
@@ -26,7 +27,7 @@ int main(int argc, char * argv[]){
 
 	action = cli.get_option(
 				"action",
-				Cli::Description("specify the action to perform --action=show|convert|clean")
+				Cli::Description("specify the action to perform --action=show|convert|clean|benchmark")
 				);
 
 	bool is_details = cli.get_option(
@@ -57,11 +58,14 @@ int main(int argc, char * argv[]){
 
 	String pour_size = cli.get_option(
 				"pour",
-				Cli::Description("specify the size of the grid pour search --pour=4")
+				Cli::Description("specify the size of the grid pour search or choose it for each glyph --pour=<3|auto>")
 				);
 
+	bool is_pour_auto = pour_size == "auto";
 	if( pour_size.to_integer() == 0 ){
-		Ap::printer().message("using 4 pixel grid pour size");
+		if( is_pour_auto == false ){
+			Ap::printer().message("using 3 pixel grid pour size");
+		}
 		pour_size = "3";
 	}
 
@@ -71,7 +75,7 @@ int main(int argc, char * argv[]){
 				);
 
 	if( downsample_size.to_integer() == 0 ){
-		Ap::printer().message("using 4 pixel grid pour size");
+		Ap::printer().message("using 4x downsampling");
 		downsample_size = "4";
 	}
 
@@ -101,6 +105,15 @@ int main(int argc, char * argv[]){
 				) == "true";
 
 
+	String jobs = cli.get_option(
+				"jobs",
+				Cli::Description("specify the number of threads used to rasterize glyphs --jobs=4")
+				);
+
+	if( jobs.to_integer() == 0 ){
+		jobs = "1";
+	}
+
 	String characters = cli.get_option(
 				"characters",
 				Cli::Description("specify the characters to process (default is ascii)")
@@ -134,6 +147,96 @@ int main(int argc, char * argv[]){
 			exit(0);
 	}
 
+	String packer = cli.get_option(
+				"packer",
+				Cli::Description("specify how characters are packed on the master canvas --packer=<skyline|scan>")
+				);
+
+	if( packer.is_empty() ){
+		packer = "skyline";
+	} else if( packer != "skyline" && packer != "scan" ){
+		Ap::printer().error("use --packer=<skyline|scan>");
+		exit(0);
+	}
+
+	enum FontObject::packer packer_type =
+			packer == "scan" ?
+				FontObject::PACKER_SCAN :
+				FontObject::PACKER_SKYLINE;
+
+	String fill = cli.get_option(
+				"fill",
+				Cli::Description("specify how glyphs are filled --fill=<pour|scanline|coverage>")
+				);
+
+	if( fill.is_empty() ){
+		fill = "pour";
+	} else if( fill != "pour" && fill != "scanline" && fill != "coverage" ){
+		Ap::printer().error("use --fill=<pour|scanline|coverage>");
+		exit(0);
+	}
+
+	String fill_rule = cli.get_option(
+				"fill-rule",
+				Cli::Description("specify the winding rule used with --fill=scanline|coverage or --pour-test=winding --fill-rule=<nonzero|evenodd>")
+				);
+
+	if( fill_rule.is_empty() ){
+		fill_rule = "nonzero";
+	} else if( fill_rule != "nonzero" && fill_rule != "evenodd" ){
+		Ap::printer().error("use --fill-rule=<nonzero|evenodd>");
+		exit(0);
+	}
+
+	String pour_select = cli.get_option(
+				"pour-select",
+				Cli::Description("specify how the pour point of each fill region is chosen --pour-select=<distance|spacing>")
+				);
+
+	if( pour_select.is_empty() ){
+		pour_select = "distance";
+	} else if( pour_select != "distance" && pour_select != "spacing" ){
+		Ap::printer().error("use --pour-select=<distance|spacing>");
+		exit(0);
+	}
+
+	String pour_test = cli.get_option(
+				"pour-test",
+				Cli::Description("specify how pour candidates are found inside a glyph --pour-test=<raster|winding>")
+				);
+
+	if( pour_test.is_empty() ){
+		pour_test = "raster";
+	} else if( pour_test != "raster" && pour_test != "winding" ){
+		Ap::printer().error("use --pour-test=<raster|winding>");
+		exit(0);
+	}
+
+	bool is_multires = cli.get_option(
+				"multires",
+				Cli::Description("find pour points from the runs of each row instead of per-pixel maps --multires")
+				) == "true";
+
+	String flatness = cli.get_option(
+				"flatness",
+				Cli::Description("specify how far in canvas pixels flattened curves may stray from the path (default is a quarter of an output pixel) --flatness=0.5")
+				);
+
+	if( !flatness.is_empty() && flatness.to_float() <= 0.0f ){
+		Ap::printer().error("use --flatness=<pixels> with a value greater than zero");
+		exit(0);
+	}
+
+	String quarantine = cli.get_option(
+				"quarantine",
+				Cli::Description("move icons that fail to convert into a directory --quarantine=failed")
+				);
+
+	String canvas_budget = cli.get_option(
+				"canvas-budget",
+				Cli::Description("specify the maximum size in bytes of each master canvas (default is the size of the default page) --canvas-budget=4096")
+				);
+
 	if( cli.get_option("help") != "true" ){
 		Ap::printer().open_object("options");
 		{
@@ -143,11 +246,21 @@ int main(int argc, char * argv[]){
 			Ap::printer().key("output", output.is_empty() ? "<auto>" : output.cstring() );
 			Ap::printer().key("canvas", canvas_size);
 			Ap::printer().key("downsample", downsample_size);
-			Ap::printer().key("pour", pour_size);
+			Ap::printer().key("pour", is_pour_auto ? "auto" : pour_size.cstring());
 			Ap::printer().key("overwrite", is_overwrite ? "true" : "false");
 			Ap::printer().key("characters", characters.is_empty() ? "<ascii>" : characters.cstring() );
 			Ap::printer().key("bitsPerPixel", bits_per_pixel);
 			Ap::printer().key("json", is_json ? "true" : "false");
+			Ap::printer().key("jobs", jobs);
+			Ap::printer().key("packer", packer);
+			Ap::printer().key("fill", fill);
+			Ap::printer().key("fillRule", fill_rule);
+			Ap::printer().key("pourSelect", pour_select);
+			Ap::printer().key("pourTest", pour_test);
+			Ap::printer().key("multires", is_multires ? "true" : "false");
+			Ap::printer().key("flatness", flatness.is_empty() ? "<auto>" : flatness.cstring());
+			Ap::printer().key("quarantine", quarantine.is_empty() ? "<none>" : quarantine.cstring());
+			Ap::printer().key("canvasBudget", canvas_budget.to_integer() ? canvas_budget.cstring() : "<none>");
 			Ap::printer().close_object();
 		}
 	}
@@ -201,6 +314,27 @@ int main(int argc, char * argv[]){
 		exit(0);
 	}
 
+	if( action == "benchmark" ){
+		String iterations = cli.get_option(
+					"iterations",
+					Cli::Description("specify the number of benchmark iterations --iterations=10")
+					);
+
+		if( iterations.to_integer() == 0 ){
+			iterations = "10";
+		}
+
+		int result = Benchmark::run(
+					cli.get_option(
+						"benchmark",
+						Cli::Description("specify the benchmark to run --benchmark=path|icons|codepoints|regions|rows|fill|multires|winding|grid|flatness|fit")
+						),
+					File::SourcePath(input),
+					Benchmark::Iterations(iterations.to_integer())
+					);
+		exit(result < 0 ? 1 : 0);
+	}
+
 	if( action == "convert" ){
 
 		Ap::printer().message("converting");
@@ -217,6 +351,35 @@ int main(int argc, char * argv[]){
 			svg_font.set_bits_per_pixel(bits_per_pixel.to_integer());
 			svg_font.set_output_json(is_json);
 			svg_font.set_pour_grid_size( pour_size.to_integer() );
+			svg_font.set_pour_grid_auto( is_pour_auto );
+			svg_font.set_jobs( jobs.to_integer() );
+			if( fill == "scanline" ){
+				svg_font.set_fill(SvgFontManager::FILL_SCANLINE);
+			} else if( fill == "coverage" ){
+				svg_font.set_fill(SvgFontManager::FILL_COVERAGE);
+			} else {
+				svg_font.set_fill(SvgFontManager::FILL_POUR);
+			}
+			svg_font.set_fill_rule(
+						fill_rule == "evenodd" ?
+							ScanlineRasterizer::FILL_RULE_EVENODD :
+							ScanlineRasterizer::FILL_RULE_NONZERO
+							);
+			svg_font.set_pour_select(
+						pour_select == "spacing" ?
+							SvgFontManager::POUR_SELECT_SPACING :
+							SvgFontManager::POUR_SELECT_DISTANCE
+							);
+			svg_font.set_pour_test(
+						pour_test == "winding" ?
+							SvgFontManager::POUR_TEST_WINDING :
+							SvgFontManager::POUR_TEST_RASTER
+							);
+			svg_font.set_multires(is_multires);
+			svg_font.set_flatness(flatness.to_float());
+			svg_font.set_quarantine_path(quarantine);
+			svg_font.set_packer(packer_type);
+			svg_font.set_canvas_budget(canvas_budget.to_integer());
 			svg_font.set_canvas_size( canvas_size.to_integer() );
 			svg_font.set_generate_map(is_map);
 			svg_font.set_downsample_factor(
@@ -233,24 +396,33 @@ int main(int argc, char * argv[]){
 							input.cstring()
 							);
 
-				svg_font.process_icons(
-							File::SourcePath(input),
-							File::DestinationPath(output)
-							);
+				//failed icons are left out -- the rest are still written
+				if( (svg_font.process_icons(
+						  File::SourcePath(input),
+						  File::DestinationPath(output)
+						  ) < 0) ||
+					 svg_font.failure_count() ){
+					return 1;
+				}
 			} else {
 				//svg file with a converted TTF
 				Ap::printer().message("convert font file");
 				svg_font.set_character_set(characters);
 				svg_font.set_flip_y(true);
-				svg_font.process_font(
-							File::SourcePath(input),
-							File::DestinationPath(output)
-							);
+				if( (svg_font.process_font(
+						  File::SourcePath(input),
+						  File::DestinationPath(output)
+						  ) < 0) ||
+					 svg_font.failure_count() ){
+					return 1;
+				}
 			}
 		} else if( input_suffix == "json" ){
 			//map file input
 			Ap::printer().message("generating sbf font from map file");
 			BmpFontGenerator bmp_font_generator;
+			bmp_font_generator.set_packer(packer_type);
+			bmp_font_generator.set_canvas_budget(canvas_budget.to_integer());
 			if( bmp_font_generator.import_map(input) == 0 ){
 
 				if( File::get_info(output).is_directory() ){
@@ -270,6 +442,8 @@ int main(int argc, char * argv[]){
 
 			BmpFontManager bmp_font_manager;
 			bmp_font_manager.set_bits_per_pixel(bits_per_pixel.to_integer());
+			bmp_font_manager.set_packer(packer_type);
+			bmp_font_manager.set_canvas_budget(canvas_budget.to_integer());
 			if( is_map ){
 				bmp_font_manager.set_generate_map(true);
 			}
@@ -286,6 +460,8 @@ int main(int argc, char * argv[]){
 
 			BmpFontManager bmp_font_manager;
 			bmp_font_manager.set_bits_per_pixel(bits_per_pixel.to_integer());
+			bmp_font_manager.set_packer(packer_type);
+			bmp_font_manager.set_canvas_budget(canvas_budget.to_integer());
 			bmp_font_manager.generate_map(input);
 			exit(0);
 		}